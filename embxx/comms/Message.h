@@ -21,8 +21,10 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <algorithm>
+#include <tuple>
 #include <type_traits>
 
 #include "embxx/util/Assert.h"
@@ -38,6 +40,66 @@ namespace embxx
 namespace comms
 {
 
+namespace details
+{
+
+/// @cond DOCUMENT_FIELDS_STATIC_LENGTH
+// Check whether the field defines static constexpr length() function, i.e.
+// its serialisation length doesn't depend on the value.
+template <typename TField>
+struct FieldHasStaticLength
+{
+    template <typename T>
+    static std::true_type test(std::integral_constant<std::size_t, T::length()>*);
+
+    template <typename T>
+    static std::false_type test(...);
+
+    static const bool Value = decltype(test<TField>(nullptr))::value;
+};
+
+template <typename TField, bool THasStaticLength>
+struct FieldStaticLength
+{
+    static const std::size_t Value = TField::length();
+};
+
+template <typename TField>
+struct FieldStaticLength<TField, false>
+{
+    static const std::size_t Value = 0;
+};
+
+// Sum of the serialisation lengths of all the fields when all of them have
+// static length, Fixed is false otherwise.
+template <typename TFields>
+struct FieldsStaticLength;
+
+template <>
+struct FieldsStaticLength<std::tuple<> >
+{
+    static const bool Fixed = true;
+    static const std::size_t Value = 0;
+};
+
+template <typename TFirst, typename... TRest>
+struct FieldsStaticLength<std::tuple<TFirst, TRest...> >
+{
+    typedef FieldsStaticLength<std::tuple<TRest...> > RestLength;
+
+    static const bool Fixed =
+        FieldHasStaticLength<TFirst>::Value && RestLength::Fixed;
+
+    static const std::size_t Value =
+        Fixed ?
+            (FieldStaticLength<TFirst, FieldHasStaticLength<TFirst>::Value>::Value +
+                RestLength::Value) :
+            0;
+};
+/// @endcond
+
+}  // namespace details
+
 /// @addtogroup comms
 /// @{
 
@@ -317,6 +379,13 @@ class EmptyBodyMessage : public MessageBase<TId, TBase, TActual>
 
 public:
 
+    /// @brief Serialisation length of the message body is known at
+    ///        compile time.
+    static const bool HasFixedLength = true;
+
+    /// @brief Serialisation length of the message body.
+    static const std::size_t FixedLength = 0;
+
     // Destructor
     virtual ~EmptyBodyMessage();
 
@@ -385,6 +454,19 @@ public:
     /// @brief Fields tuple
     typedef TFields Fields;
 
+    /// @brief Whether serialisation length of the message body is known at
+    ///        compile time.
+    /// @details True when all the fields define static constexpr length()
+    ///          member function, i.e. their length doesn't depend on the
+    ///          value.
+    static const bool HasFixedLength =
+        details::FieldsStaticLength<Fields>::Fixed;
+
+    /// @brief Serialisation length of the message body when HasFixedLength
+    ///        is true, 0 otherwise.
+    static const std::size_t FixedLength =
+        details::FieldsStaticLength<Fields>::Value;
+
     /// @brief Default constructor
     MetaMessageBase() = default;
 
@@ -410,26 +492,35 @@ protected:
     typedef typename Base::WriteIterator WriteIterator;
 
     /// @brief Implements read body behaviour.
-    /// @details Calls read() member function of every element in TFields.
+    /// @details Calls read() member function of every element in TFields,
+    ///          stops on the first failure.
     /// @return ErrorStatus::Success if all read operations are successful.
     virtual ErrorStatus readImpl(
         ReadIterator& iter,
         std::size_t size) override;
 
     /// @brief Implements write body behaviour.
-    /// @details Calls write() member function of every element in TField
+    /// @details Calls write() member function of every element in TField,
+    ///          stops on the first failure.
     /// @return ErrorStatus::Success if all write operations are successful.
     virtual ErrorStatus writeImpl(
         WriteIterator& iter,
         std::size_t size) const override;
 
     /// @brief Implements serialisation size retrieval.
-    /// @details Calls length() member functio nof every element it TField
+    /// @details Returns FixedLength when HasFixedLength is true, otherwise
+    ///          calls length() member function of every element it TField
     ///          and sums the result
     /// @return Number of bytes required to serialise all fields in TField
     virtual std::size_t lengthImpl() const override;
 
 private:
+    std::size_t lengthInternal(std::true_type) const;
+    std::size_t lengthInternal(std::false_type) const;
+    ErrorStatus readInternal(ReadIterator& iter, std::size_t size, std::true_type);
+    ErrorStatus readInternal(ReadIterator& iter, std::size_t size, std::false_type);
+    ErrorStatus writeInternal(WriteIterator& iter, std::size_t size, std::true_type) const;
+    ErrorStatus writeInternal(WriteIterator& iter, std::size_t size, std::false_type) const;
 
     /// @cond DOCUMENT_FIELD_READER_WRITER_SIZE_GETTER
     class FieldReader
@@ -444,18 +535,19 @@ private:
         }
 
         template <typename TField>
-        void operator()(TField& field) {
-            if (status_ == ErrorStatus::Success) {
-                status_ = field.read(iter_, size_);
-                if (status_ == ErrorStatus::Success) {
-                    GASSERT(field.length() <= size_);
-                    size_ -= field.length();
-                }
+        bool operator()(TField& field) {
+            status_ = field.read(iter_, size_);
+            if (status_ != ErrorStatus::Success) {
+                return false;
             }
+
+            GASSERT(field.length() <= size_);
+            size_ -= field.length();
+            return true;
         }
     private:
         ReadIterator& iter_;
-        ErrorStatus status_;
+        ErrorStatus& status_;
         std::size_t& size_;
     };
 
@@ -470,23 +562,68 @@ private:
         }
 
         template <typename TField>
-        void operator()(TField& field) {
-            if (status_ == ErrorStatus::Success) {
-                status_ = field.write(iter_, size_);
-                if (status_ == ErrorStatus::Success) {
-                    GASSERT(field.length() <= size_);
-                    size_ -= field.length();
-                }
+        bool operator()(const TField& field) {
+            status_ = field.write(iter_, size_);
+            if (status_ != ErrorStatus::Success) {
+                return false;
             }
+
+            GASSERT(field.length() <= size_);
+            size_ -= field.length();
+            return true;
         }
 
     private:
         WriteIterator& iter_;
-        ErrorStatus status_;
+        ErrorStatus& status_;
         std::size_t& size_;
     };
 
 
+    // Used when all the fields have static length and available size has
+    // been checked for the whole message. The static length of the field
+    // is passed as available size, which allows compiler to drop per field
+    // bounds checks.
+    class FixedFieldReader
+    {
+    public:
+        FixedFieldReader(ReadIterator& iter, ErrorStatus& status)
+            : iter_(iter),
+              status_(status)
+        {
+        }
+
+        template <typename TField>
+        bool operator()(TField& field) {
+            status_ = field.read(iter_, TField::length());
+            return status_ == ErrorStatus::Success;
+        }
+
+    private:
+        ReadIterator& iter_;
+        ErrorStatus& status_;
+    };
+
+    class FixedFieldWriter
+    {
+    public:
+        FixedFieldWriter(WriteIterator& iter, ErrorStatus& status)
+            : iter_(iter),
+              status_(status)
+        {
+        }
+
+        template <typename TField>
+        bool operator()(const TField& field) {
+            status_ = field.write(iter_, TField::length());
+            return status_ == ErrorStatus::Success;
+        }
+
+    private:
+        WriteIterator& iter_;
+        ErrorStatus& status_;
+    };
+
     struct FieldLengthRetriever
     {
         template <typename TField>
@@ -657,6 +794,16 @@ std::size_t EmptyBodyMessage<TId, TBase, TActual>::lengthImpl() const
     return 0;
 }
 
+template <typename traits::MsgIdType TId,
+          typename TBase,
+          typename TActual>
+const bool EmptyBodyMessage<TId, TBase, TActual>::HasFixedLength;
+
+template <typename traits::MsgIdType TId,
+          typename TBase,
+          typename TActual>
+const std::size_t EmptyBodyMessage<TId, TBase, TActual>::FixedLength;
+
 template <traits::MsgIdType TId,
           typename TBase,
           typename TActual,
@@ -713,10 +860,7 @@ ErrorStatus MetaMessageBase<TId, TBase, TActual, TFields>::readImpl(
     ReadIterator& iter,
     std::size_t size)
 {
-    ErrorStatus status = ErrorStatus::Success;
-    std::size_t remainingSize = size;
-    util::tupleForEach(fields_, FieldReader(iter, status, remainingSize));
-    return status;
+    return readInternal(iter, size, std::integral_constant<bool, HasFixedLength>());
 }
 
 template <traits::MsgIdType TId,
@@ -726,10 +870,69 @@ template <traits::MsgIdType TId,
 ErrorStatus MetaMessageBase<TId, TBase, TActual, TFields>::writeImpl(
     WriteIterator& iter,
     std::size_t size) const
+{
+    return writeInternal(iter, size, std::integral_constant<bool, HasFixedLength>());
+}
+
+template <traits::MsgIdType TId,
+          typename TBase,
+          typename TActual,
+          typename TFields>
+std::size_t MetaMessageBase<TId, TBase, TActual, TFields>::lengthImpl() const
+{
+    return lengthInternal(std::integral_constant<bool, HasFixedLength>());
+}
+
+template <traits::MsgIdType TId,
+          typename TBase,
+          typename TActual,
+          typename TFields>
+std::size_t MetaMessageBase<TId, TBase, TActual, TFields>::lengthInternal(
+    std::true_type) const
+{
+    return FixedLength;
+}
+
+template <traits::MsgIdType TId,
+          typename TBase,
+          typename TActual,
+          typename TFields>
+std::size_t MetaMessageBase<TId, TBase, TActual, TFields>::lengthInternal(
+    std::false_type) const
+{
+    return util::tupleAccumulate(fields_, 0U, FieldLengthRetriever());
+}
+
+template <traits::MsgIdType TId,
+          typename TBase,
+          typename TActual,
+          typename TFields>
+ErrorStatus MetaMessageBase<TId, TBase, TActual, TFields>::readInternal(
+    ReadIterator& iter,
+    std::size_t size,
+    std::true_type)
+{
+    if (size < FixedLength) {
+        return ErrorStatus::NotEnoughData;
+    }
+
+    ErrorStatus status = ErrorStatus::Success;
+    util::tupleForEachUntil(fields_, FixedFieldReader(iter, status));
+    return status;
+}
+
+template <traits::MsgIdType TId,
+          typename TBase,
+          typename TActual,
+          typename TFields>
+ErrorStatus MetaMessageBase<TId, TBase, TActual, TFields>::readInternal(
+    ReadIterator& iter,
+    std::size_t size,
+    std::false_type)
 {
     ErrorStatus status = ErrorStatus::Success;
     std::size_t remainingSize = size;
-    util::tupleForEach(fields_, FieldWriter(iter, status, remainingSize));
+    util::tupleForEachUntil(fields_, FieldReader(iter, status, remainingSize));
     return status;
 }
 
@@ -737,11 +940,47 @@ template <traits::MsgIdType TId,
           typename TBase,
           typename TActual,
           typename TFields>
-std::size_t MetaMessageBase<TId, TBase, TActual, TFields>::lengthImpl() const
+ErrorStatus MetaMessageBase<TId, TBase, TActual, TFields>::writeInternal(
+    WriteIterator& iter,
+    std::size_t size,
+    std::true_type) const
 {
-    return util::tupleAccumulate(fields_, 0U, FieldLengthRetriever());
+    if (size < FixedLength) {
+        return ErrorStatus::BufferOverflow;
+    }
+
+    ErrorStatus status = ErrorStatus::Success;
+    util::tupleForEachUntil(fields_, FixedFieldWriter(iter, status));
+    return status;
+}
+
+template <traits::MsgIdType TId,
+          typename TBase,
+          typename TActual,
+          typename TFields>
+ErrorStatus MetaMessageBase<TId, TBase, TActual, TFields>::writeInternal(
+    WriteIterator& iter,
+    std::size_t size,
+    std::false_type) const
+{
+    ErrorStatus status = ErrorStatus::Success;
+    std::size_t remainingSize = size;
+    util::tupleForEachUntil(fields_, FieldWriter(iter, status, remainingSize));
+    return status;
 }
 
+template <traits::MsgIdType TId,
+          typename TBase,
+          typename TActual,
+          typename TFields>
+const bool MetaMessageBase<TId, TBase, TActual, TFields>::HasFixedLength;
+
+template <traits::MsgIdType TId,
+          typename TBase,
+          typename TActual,
+          typename TFields>
+const std::size_t MetaMessageBase<TId, TBase, TActual, TFields>::FixedLength;
+
 
 }  // namespace comms
 
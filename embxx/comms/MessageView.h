@@ -0,0 +1,309 @@
+//
+// Copyright 2014 (C). Alex Robenko. All rights reserved.
+//
+
+// This library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file embxx/comms/MessageView.h
+/// This file contains definition of lazy message view over serialised data.
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+
+#include "embxx/util/Assert.h"
+#include "embxx/util/Tuple.h"
+#include "ErrorStatus.h"
+#include "Message.h"
+
+namespace embxx
+{
+
+namespace comms
+{
+
+namespace details
+{
+
+/// @cond DOCUMENT_MESSAGE_VIEW_DETAILS
+template <typename TIter>
+class MessageViewOffsetsCalc
+{
+public:
+    MessageViewOffsetsCalc(
+        TIter iter,
+        std::size_t size,
+        std::size_t* offsets,
+        ErrorStatus& status)
+        : iter_(iter),
+          size_(size),
+          offsets_(offsets),
+          status_(status),
+          idx_(0)
+    {
+    }
+
+    template <typename TField>
+    bool operator()(TField& field)
+    {
+        auto offset = offsets_[idx_];
+        auto len = fieldLength(
+            field,
+            offset,
+            std::integral_constant<bool, FieldHasStaticLength<TField>::Value>());
+
+        if (status_ != ErrorStatus::Success) {
+            return false;
+        }
+
+        if (size_ < (offset + len)) {
+            status_ = ErrorStatus::NotEnoughData;
+            return false;
+        }
+
+        ++idx_;
+        offsets_[idx_] = offset + len;
+        return true;
+    }
+
+private:
+    template <typename TField>
+    std::size_t fieldLength(TField& field, std::size_t offset, std::true_type)
+    {
+        static_cast<void>(field);
+        static_cast<void>(offset);
+        return TField::length();
+    }
+
+    template <typename TField>
+    std::size_t fieldLength(TField& field, std::size_t offset, std::false_type)
+    {
+        if (size_ < offset) {
+            status_ = ErrorStatus::NotEnoughData;
+            return 0;
+        }
+
+        auto iter = iter_;
+        std::advance(iter, offset);
+        status_ = field.read(iter, size_ - offset);
+        return field.length();
+    }
+
+    TIter iter_;
+    std::size_t size_;
+    std::size_t* offsets_;
+    ErrorStatus& status_;
+    std::size_t idx_;
+};
+/// @endcond
+
+}  // namespace details
+
+/// @ingroup comms
+/// @brief Lazy view of the serialised message contents.
+/// @details Unlike read() of the message object, which deserialises all the
+///          fields, the view only validates that the data is long enough to
+///          contain all the fields and records the offset of every field.
+///          The field is deserialised from the viewed data only when it is
+///          accessed with field(). It suits forwarding and filtering
+///          of the messages, when only one or two fields are inspected and
+///          allocation of the message object is not needed.
+///
+///          The lengths of the fields that define static constexpr length()
+///          member function are not checked by reading the data. The other
+///          fields are read once during reset() to discover their length.
+///
+///          The iterator to the payload of the received message and its
+///          size may be obtained with readView() member function of
+///          embxx::comms::protocol::MsgIdLayer, which doesn't allocate the
+///          message object.
+/// @tparam TMsg Message type derived from embxx::comms::MetaMessageBase
+///         (must define Fields tuple type).
+/// @tparam TIter Type of the iterator to the serialised data (payload of
+///         the message), defaults to ReadIterator defined in the message
+///         traits. Random access iterator is recommended, because the
+///         iterator is advanced to the field offset on every access.
+/// @pre The viewed data must remain valid and unchanged while the view is
+///      used.
+/// @headerfile embxx/comms/MessageView.h
+template <typename TMsg, typename TIter = typename TMsg::Traits::ReadIterator>
+class MessageView
+{
+public:
+    /// @brief Type of the viewed message
+    typedef TMsg Message;
+
+    /// @brief All the fields of the message bundled in std::tuple
+    typedef typename Message::Fields Fields;
+
+    /// @brief Type of the iterator to the viewed data
+    typedef TIter Iterator;
+
+    /// @brief Number of fields
+    static const std::size_t NumOfFields = std::tuple_size<Fields>::value;
+
+    /// @brief Type of the field with specified index
+    template <std::size_t TIdx>
+    using FieldType = typename std::tuple_element<TIdx, Fields>::type;
+
+    /// @brief Default constructor, creates invalid view.
+    MessageView();
+
+    /// @brief Constructor
+    /// @details Calls reset() with provided parameters, use valid() to check
+    ///          the result.
+    MessageView(Iterator iter, std::size_t size);
+
+    /// @brief Assign the serialised data to the view.
+    /// @details Validates the data contains all the fields.
+    /// @param[in] iter Iterator to the beginning of the message payload.
+    /// @param[in] size Size of the data.
+    /// @return ErrorStatus::Success if the data contains all the fields,
+    ///         ErrorStatus::NotEnoughData or error reported by one of the
+    ///         fields otherwise.
+    /// @post The view is valid if and only if ErrorStatus::Success is returned.
+    /// @note Thread safety: Unsafe
+    /// @note Exception guarantee: Basic
+    ErrorStatus reset(Iterator iter, std::size_t size);
+
+    /// @brief Check whether the view is valid
+    bool valid() const;
+
+    /// @brief Get iterator to the beginning of the viewed data.
+    /// @pre The view is valid.
+    Iterator begin() const;
+
+    /// @brief Get serialisation length of all the fields.
+    /// @pre The view is valid.
+    std::size_t length() const;
+
+    /// @brief Get offset of the field from the beginning of the viewed data.
+    /// @pre The view is valid.
+    template <std::size_t TIdx>
+    std::size_t fieldOffset() const;
+
+    /// @brief Deserialise single field.
+    /// @tparam TIdx Index of the field in Fields tuple.
+    /// @return Field object.
+    /// @pre The view is valid.
+    template <std::size_t TIdx>
+    FieldType<TIdx> field() const;
+
+    /// @brief Deserialise all the fields into the message object.
+    /// @param[out] msg Message object.
+    /// @return Status of the read operation.
+    /// @pre The view is valid.
+    ErrorStatus read(Message& msg) const;
+
+private:
+    Iterator iter_;
+    std::size_t offsets_[NumOfFields + 1];
+    bool valid_;
+};
+
+// Implementation
+template <typename TMsg, typename TIter>
+MessageView<TMsg, TIter>::MessageView()
+    : iter_(),
+      valid_(false)
+{
+    offsets_[0] = 0;
+}
+
+template <typename TMsg, typename TIter>
+MessageView<TMsg, TIter>::MessageView(Iterator iter, std::size_t size)
+    : iter_(iter),
+      valid_(false)
+{
+    offsets_[0] = 0;
+    reset(iter, size);
+}
+
+template <typename TMsg, typename TIter>
+ErrorStatus MessageView<TMsg, TIter>::reset(Iterator iter, std::size_t size)
+{
+    iter_ = iter;
+    offsets_[0] = 0;
+
+    Fields fields;
+    auto status = ErrorStatus::Success;
+    util::tupleForEachUntil(
+        fields,
+        details::MessageViewOffsetsCalc<Iterator>(iter, size, &offsets_[0], status));
+
+    valid_ = (status == ErrorStatus::Success);
+    return status;
+}
+
+template <typename TMsg, typename TIter>
+bool MessageView<TMsg, TIter>::valid() const
+{
+    return valid_;
+}
+
+template <typename TMsg, typename TIter>
+typename MessageView<TMsg, TIter>::Iterator
+MessageView<TMsg, TIter>::begin() const
+{
+    GASSERT(valid_);
+    return iter_;
+}
+
+template <typename TMsg, typename TIter>
+std::size_t MessageView<TMsg, TIter>::length() const
+{
+    GASSERT(valid_);
+    return offsets_[NumOfFields];
+}
+
+template <typename TMsg, typename TIter>
+template <std::size_t TIdx>
+std::size_t MessageView<TMsg, TIter>::fieldOffset() const
+{
+    static_assert(TIdx < NumOfFields, "Invalid field index");
+    GASSERT(valid_);
+    return offsets_[TIdx];
+}
+
+template <typename TMsg, typename TIter>
+template <std::size_t TIdx>
+typename MessageView<TMsg, TIter>::template FieldType<TIdx>
+MessageView<TMsg, TIter>::field() const
+{
+    static_assert(TIdx < NumOfFields, "Invalid field index");
+    GASSERT(valid_);
+
+    FieldType<TIdx> fieldObj;
+    auto iter = iter_;
+    std::advance(iter, offsets_[TIdx]);
+    auto status = fieldObj.read(iter, offsets_[TIdx + 1] - offsets_[TIdx]);
+    static_cast<void>(status);
+    GASSERT(status == ErrorStatus::Success);
+    return fieldObj;
+}
+
+template <typename TMsg, typename TIter>
+ErrorStatus MessageView<TMsg, TIter>::read(Message& msg) const
+{
+    GASSERT(valid_);
+    auto iter = iter_;
+    return msg.read(iter, length());
+}
+
+}  // namespace comms
+
+}  // namespace embxx
@@ -20,6 +20,8 @@
 
 #pragma once
 
+#include <cstddef>
+
 #include "embxx/util/Allocators.h"
 
 namespace embxx
@@ -46,9 +48,61 @@ class DynMemMsgAllocator : public embxx::util::DynMemAllocator
 ///          deleter that calls destructor of the object.
 /// @tparam TTuple std::tuple<...> with all the types of messages this allocator
 ///          can allocate
+/// @tparam TStats Allocation statistics policy, see embxx::util::AllocStats.
+///         By default nothing is recorded.
+/// @headerfile embxx/comms/MsgAllocators.h
+template <typename TAllMessages,
+          typename TStats = embxx::util::NoAllocStats>
+class InPlaceMsgAllocator :
+    public embxx::util::SpecificInPlaceAllocator<TAllMessages, TStats>
+{
+};
+
+/// @brief Message object allocation policy that uses "in place" object
+///        construction in one of several pre-allocated slots.
+/// @details Similar to InPlaceMsgAllocator, but allows up to TCount message
+///          objects to exist at the same time. The size of every slot is
+///          determined by the largest type in TAllMessages. It allows
+///          reading of the next message while the previous ones are still
+///          being handled. The slot is returned to the pool when the
+///          std::unique_ptr holding the message is destructed.
+/// @tparam TAllMessages std::tuple<...> with all the types of messages this
+///         allocator can allocate
+/// @tparam TCount Number of message objects that may exist at the same time.
+/// @tparam TLock "Lockable" class (such as std::mutex) if the messages are
+///         released in a thread other than the one reading them.
+///         By default no locking is performed.
+/// @headerfile embxx/comms/MsgAllocators.h
+template <typename TAllMessages,
+          std::size_t TCount,
+          typename TLock = embxx::util::details::PoolInPlaceAllocatorNoLock>
+class PoolInPlaceMsgAllocator :
+    public embxx::util::SpecificPoolInPlaceAllocator<TAllMessages, TCount, TLock>
+{
+};
+
+/// @brief Message object allocation policy that uses "in place" object
+///        construction in one of several pre-allocated slots and returns
+///        reference counting pointer.
+/// @details The message object is returned wrapped in embxx::util::IntrusivePtr,
+///          which can be copied to deliver the same message object to
+///          several handlers. The slot is returned to the pool when the
+///          last pointer to the message is destructed.
+/// @tparam TAllMessages std::tuple<...> with all the types of messages this
+///         allocator can allocate
+/// @tparam TCount Number of message objects that may exist at the same time.
+/// @tparam TRefCount Type of the reference counter: std::size_t (default) or
+///         std::atomic<std::size_t> if the pointers are shared between
+///         threads.
+/// @tparam TLock "Lockable" class (such as std::mutex) if the messages are
+///         released in a thread other than the one reading them.
 /// @headerfile embxx/comms/MsgAllocators.h
-template <typename TAllMessages>
-class InPlaceMsgAllocator : public embxx::util::SpecificInPlaceAllocator<TAllMessages>
+template <typename TAllMessages,
+          std::size_t TCount,
+          typename TRefCount = std::size_t,
+          typename TLock = embxx::util::details::PoolInPlaceAllocatorNoLock>
+class RefCountedPoolMsgAllocator :
+    public embxx::util::SpecificRefCountedPoolAllocator<TAllMessages, TCount, TRefCount, TLock>
 {
 };
 
@@ -0,0 +1,492 @@
+//
+// Copyright 2014 (C). Alex Robenko. All rights reserved.
+//
+
+// This library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file embxx/comms/MsgIdTable.h
+/// Compile time generated lookup of message type by its ID.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+
+#include "embxx/util/Tuple.h"
+#include "embxx/util/SizeToType.h"
+#include "traits.h"
+
+namespace embxx
+{
+
+namespace comms
+{
+
+namespace details
+{
+
+/// @cond DOCUMENT_MSG_ID_TABLE
+template <std::size_t TEndIdx, typename TAllMessages>
+struct AreMessagesSorted
+{
+    typedef typename std::tuple_element<TEndIdx - 2, TAllMessages>::type FirstElemType;
+    typedef typename std::tuple_element<TEndIdx - 1, TAllMessages>::type SecondElemType;
+
+    static const bool Value =
+        ((FirstElemType::MsgId < SecondElemType::MsgId) &&
+         (AreMessagesSorted<TEndIdx - 1, TAllMessages>::Value));
+};
+
+template <typename TAllMessages>
+struct AreMessagesSorted<1, TAllMessages>
+{
+    static const bool Value = true;
+};
+
+template <typename TAllMessages>
+struct AreMessagesSorted<0, TAllMessages>
+{
+    static const bool Value = true;
+};
+
+// Smallest unsigned type that can hold indices of the message types,
+// including the number of messages reported for unknown IDs.
+template <std::size_t TNumOfMsgs>
+struct MsgIdxType
+{
+    typedef typename util::SizeToType<
+        (TNumOfMsgs <= 0xff) ? 1 : ((TNumOfMsgs <= 0xffff) ? 2 : 4)
+    >::Type Type;
+};
+
+// Compile time generated two level perfect hash of sparse message IDs.
+// The IDs are distributed into power of two number of buckets (not less
+// than number of IDs). The IDs of every bucket get their own area in the
+// slots table, which size is power of two not less than square of the
+// number of IDs in the bucket. The seed of the second level hash is chosen
+// at compile time for every bucket, so the IDs of the bucket don't collide.
+// All the compile time loops split the range in two halves, so the recursion
+// depth is logarithmic.
+struct MsgIdHashFunc
+{
+    typedef traits::MsgIdType MsgIdType;
+
+    // Search for the collision free seed of the bucket stops here
+    static const std::uint32_t MaxSeed = 255;
+
+    // The second level hash takes 8 bits of the mixed value
+    static const std::size_t MaxBucketSlots = 256;
+
+    static constexpr std::uint32_t mix(MsgIdType id, std::uint32_t seed)
+    {
+        return (static_cast<std::uint32_t>(id) ^ (seed * 0x85ebca6bU)) * 0x9e3779b1U;
+    }
+
+    static constexpr std::size_t bucket(MsgIdType id, std::size_t mask)
+    {
+        return static_cast<std::size_t>(mix(id, 0) >> 16) & mask;
+    }
+
+    static constexpr std::size_t slot(MsgIdType id, std::uint32_t seed, std::size_t mask)
+    {
+        return static_cast<std::size_t>(mix(id, seed + 1) >> 24) & mask;
+    }
+
+    static constexpr std::size_t pow2AtLeast(std::size_t value, std::size_t result = 1)
+    {
+        return (value <= result) ? result : pow2AtLeast(value, result * 2);
+    }
+
+    static constexpr std::size_t slotsFor(std::size_t count)
+    {
+        return (count == 0) ? 0 : pow2AtLeast(count * count);
+    }
+
+    static constexpr std::size_t mid(std::size_t from, std::size_t to)
+    {
+        return from + ((to - from) / 2);
+    }
+};
+
+template <traits::MsgIdType... TIds>
+struct MsgIdHashIds
+{
+    typedef traits::MsgIdType MsgIdType;
+    typedef MsgIdHashFunc Func;
+
+    static const std::size_t NumOfMsgs = sizeof...(TIds);
+    static const std::size_t NumOfBuckets = Func::pow2AtLeast(NumOfMsgs);
+    static const std::size_t BucketMask = NumOfBuckets - 1;
+
+    static constexpr MsgIdType Ids[NumOfMsgs] = {TIds...};
+
+    static constexpr std::size_t bucketOf(std::size_t idx)
+    {
+        return Func::bucket(Ids[idx], BucketMask);
+    }
+
+    static constexpr std::size_t countInBucket(
+        std::size_t bucket,
+        std::size_t from,
+        std::size_t to)
+    {
+        return
+            (to <= from) ? 0 :
+            ((to - from) == 1) ? ((bucketOf(from) == bucket) ? 1 : 0) :
+            (countInBucket(bucket, from, Func::mid(from, to)) +
+             countInBucket(bucket, Func::mid(from, to), to));
+    }
+};
+
+template <traits::MsgIdType... TIds>
+constexpr traits::MsgIdType MsgIdHashIds<TIds...>::Ids[MsgIdHashIds<TIds...>::NumOfMsgs];
+
+template <typename TIds,
+          typename TBuckets =
+              typename util::MakeIndexSequence<TIds::NumOfBuckets>::Type>
+struct MsgIdHashBuckets;
+
+template <typename TIds, std::size_t... TBuckets>
+struct MsgIdHashBuckets<TIds, util::IndexSequence<TBuckets...> >
+{
+    typedef MsgIdHashFunc Func;
+
+    static const std::size_t NumOfMsgs = TIds::NumOfMsgs;
+    static const std::size_t NumOfBuckets = TIds::NumOfBuckets;
+
+    static constexpr std::size_t Slots[NumOfBuckets] = {
+        Func::slotsFor(TIds::countInBucket(TBuckets, 0, NumOfMsgs))...
+    };
+
+    static constexpr std::size_t sumSlots(std::size_t from, std::size_t to)
+    {
+        return
+            (to <= from) ? 0 :
+            ((to - from) == 1) ? Slots[from] :
+            (sumSlots(from, Func::mid(from, to)) + sumSlots(Func::mid(from, to), to));
+    }
+
+    static constexpr std::size_t maxSlots(std::size_t from, std::size_t to)
+    {
+        return
+            (to <= from) ? 0 :
+            ((to - from) == 1) ? Slots[from] :
+            ((maxSlots(from, Func::mid(from, to)) < maxSlots(Func::mid(from, to), to)) ?
+                maxSlots(Func::mid(from, to), to) :
+                maxSlots(from, Func::mid(from, to)));
+    }
+
+    static constexpr std::size_t slotOf(std::size_t idx, std::uint32_t seed)
+    {
+        return Func::slot(TIds::Ids[idx], seed, Slots[TIds::bucketOf(idx)] - 1);
+    }
+
+    // Whether any ID of the bucket in [from, to) range collides with the
+    // ID at idx.
+    static constexpr bool collides(
+        std::size_t bucket,
+        std::uint32_t seed,
+        std::size_t idx,
+        std::size_t from,
+        std::size_t to)
+    {
+        return
+            (to <= from) ? false :
+            ((to - from) == 1) ?
+                ((TIds::bucketOf(from) == bucket) && (slotOf(from, seed) == slotOf(idx, seed))) :
+            (collides(bucket, seed, idx, from, Func::mid(from, to)) ||
+             collides(bucket, seed, idx, Func::mid(from, to), to));
+    }
+
+    static constexpr bool hasCollisions(
+        std::size_t bucket,
+        std::uint32_t seed,
+        std::size_t from,
+        std::size_t to)
+    {
+        return
+            (to <= from) ? false :
+            ((to - from) == 1) ?
+                ((TIds::bucketOf(from) == bucket) &&
+                 collides(bucket, seed, from, from + 1, NumOfMsgs)) :
+            (hasCollisions(bucket, seed, from, Func::mid(from, to)) ||
+             hasCollisions(bucket, seed, Func::mid(from, to), to));
+    }
+
+    static constexpr std::uint32_t findSeed(std::size_t bucket, std::uint32_t seed)
+    {
+        return
+            (Func::MaxSeed <= seed) ? Func::MaxSeed :
+            (!hasCollisions(bucket, seed, 0, NumOfMsgs)) ? seed :
+            findSeed(bucket, seed + 1);
+    }
+};
+
+template <typename TIds, std::size_t... TBuckets>
+constexpr std::size_t
+MsgIdHashBuckets<TIds, util::IndexSequence<TBuckets...> >::Slots[
+    MsgIdHashBuckets<TIds, util::IndexSequence<TBuckets...> >::NumOfBuckets];
+
+struct MsgIdHashBucketInfo
+{
+    std::uint32_t offset_;
+    std::uint8_t seed_;
+    std::uint8_t mask_;
+};
+
+template <typename TBuckets,
+          typename TIndices =
+              typename util::MakeIndexSequence<TBuckets::NumOfBuckets>::Type>
+struct MsgIdHashSeeds;
+
+template <typename TBuckets, std::size_t... TIndices>
+struct MsgIdHashSeeds<TBuckets, util::IndexSequence<TIndices...> >
+{
+    typedef MsgIdHashFunc Func;
+
+    static const std::size_t NumOfBuckets = TBuckets::NumOfBuckets;
+
+    static constexpr MsgIdHashBucketInfo Buckets[NumOfBuckets] = {
+        {
+            static_cast<std::uint32_t>(TBuckets::sumSlots(0, TIndices)),
+            static_cast<std::uint8_t>(TBuckets::findSeed(TIndices, 0)),
+            static_cast<std::uint8_t>(
+                (TBuckets::Slots[TIndices] == 0) ? 0 : (TBuckets::Slots[TIndices] - 1))
+        }...
+    };
+
+    static constexpr bool allSeedsFound(std::size_t from, std::size_t to)
+    {
+        return
+            (to <= from) ? true :
+            ((to - from) == 1) ? (Buckets[from].seed_ < Func::MaxSeed) :
+            (allSeedsFound(from, Func::mid(from, to)) &&
+             allSeedsFound(Func::mid(from, to), to));
+    }
+
+    static constexpr std::size_t slotOf(
+        traits::MsgIdType id,
+        const MsgIdHashBucketInfo& info)
+    {
+        return info.offset_ + Func::slot(id, info.seed_, info.mask_);
+    }
+
+    static constexpr std::size_t slotOf(traits::MsgIdType id)
+    {
+        return slotOf(id, Buckets[Func::bucket(id, NumOfBuckets - 1)]);
+    }
+};
+
+template <typename TBuckets, std::size_t... TIndices>
+constexpr MsgIdHashBucketInfo
+MsgIdHashSeeds<TBuckets, util::IndexSequence<TIndices...> >::Buckets[
+    MsgIdHashSeeds<TBuckets, util::IndexSequence<TIndices...> >::NumOfBuckets];
+
+template <typename TIds, typename TSeeds, typename TSlots>
+struct MsgIdHashSlots;
+
+template <typename TIds, typename TSeeds, std::size_t... TSlots>
+struct MsgIdHashSlots<TIds, TSeeds, util::IndexSequence<TSlots...> >
+{
+    typedef MsgIdHashFunc Func;
+
+    static const std::size_t NumOfMsgs = TIds::NumOfMsgs;
+    static const std::size_t NumOfSlots = sizeof...(TSlots);
+
+    typedef typename MsgIdxType<NumOfMsgs>::Type IndexType;
+
+    // Index of the ID occupying the slot, number of IDs if there is none.
+    static constexpr std::size_t indexAtSlot(
+        std::size_t slot,
+        std::size_t from,
+        std::size_t to)
+    {
+        return
+            (to <= from) ? NumOfMsgs :
+            ((to - from) == 1) ?
+                ((TSeeds::slotOf(TIds::Ids[from]) == slot) ? from : NumOfMsgs) :
+            ((indexAtSlot(slot, from, Func::mid(from, to)) < NumOfMsgs) ?
+                indexAtSlot(slot, from, Func::mid(from, to)) :
+                indexAtSlot(slot, Func::mid(from, to), to));
+    }
+
+    static constexpr IndexType Table[NumOfSlots] = {
+        static_cast<IndexType>(indexAtSlot(TSlots, 0, NumOfMsgs))...
+    };
+};
+
+template <typename TIds, typename TSeeds, std::size_t... TSlots>
+constexpr typename MsgIdHashSlots<TIds, TSeeds, util::IndexSequence<TSlots...> >::IndexType
+MsgIdHashSlots<TIds, TSeeds, util::IndexSequence<TSlots...> >::Table[
+    MsgIdHashSlots<TIds, TSeeds, util::IndexSequence<TSlots...> >::NumOfSlots];
+
+template <traits::MsgIdType... TIds>
+class MsgIdHash
+{
+    typedef traits::MsgIdType MsgIdType;
+    typedef MsgIdHashFunc Func;
+    typedef MsgIdHashIds<TIds...> Ids;
+    typedef MsgIdHashBuckets<Ids> Buckets;
+    typedef MsgIdHashSeeds<Buckets> Seeds;
+
+public:
+    static const std::size_t NumOfMsgs = Ids::NumOfMsgs;
+
+    // The extra last slot is referenced by empty buckets at the end.
+    static const std::size_t NumOfSlots =
+        Buckets::sumSlots(0, Ids::NumOfBuckets) + 1;
+
+    static_assert(Buckets::maxSlots(0, Ids::NumOfBuckets) <= Func::MaxBucketSlots,
+        "Too many message IDs share the same bucket of the hash table");
+
+    static_assert(Seeds::allSeedsFound(0, Ids::NumOfBuckets),
+        "Failed to find collision free hash of the message IDs");
+
+    static std::size_t find(MsgIdType id)
+    {
+        auto idx = static_cast<std::size_t>(Slots::Table[Seeds::slotOf(id)]);
+        if ((idx < NumOfMsgs) && (Ids::Ids[idx] == id)) {
+            return idx;
+        }
+        return NumOfMsgs;
+    }
+
+private:
+    typedef MsgIdHashSlots<
+        Ids,
+        Seeds,
+        typename util::MakeIndexSequence<NumOfSlots>::Type> Slots;
+};
+
+// Maps message ID to the index of the message type in TAllMessages tuple,
+// find() returns number of messages when the ID is unknown. If the IDs are
+// dense (the range between the smallest and the largest ID is not greater
+// than twice the number of messages) the index is taken from the table
+// generated at compile time, otherwise the index is found by perfect hash
+// of the IDs (MsgIdHash), which is also generated at compile time.
+template <typename TAllMessages,
+          typename TIndices =
+              typename util::MakeIndexSequence<std::tuple_size<TAllMessages>::value>::Type>
+class MsgIdTable;
+
+template <typename TAllMessages>
+class MsgIdTable<TAllMessages, util::IndexSequence<> >
+{
+public:
+    static const std::size_t NumOfMsgs = 0;
+
+    static const bool Direct = true;
+
+    static std::size_t find(traits::MsgIdType id)
+    {
+        static_cast<void>(id);
+        return NumOfMsgs;
+    }
+};
+
+template <typename TAllMessages, std::size_t... TIndices>
+class MsgIdTable<TAllMessages, util::IndexSequence<TIndices...> >
+{
+    typedef traits::MsgIdType MsgIdType;
+
+public:
+    static const std::size_t NumOfMsgs = sizeof...(TIndices);
+
+    static_assert(AreMessagesSorted<NumOfMsgs, TAllMessages>::Value,
+        "All the message types in the bundle must be sorted in ascending order "
+        "based on their MsgId");
+
+    static const MsgIdType MinId =
+        std::tuple_element<0, TAllMessages>::type::MsgId;
+
+    static const MsgIdType MaxId =
+        std::tuple_element<NumOfMsgs - 1, TAllMessages>::type::MsgId;
+
+    static const std::size_t Span = static_cast<std::size_t>(MaxId - MinId) + 1;
+
+    static const bool Direct = (Span <= (NumOfMsgs * 2));
+
+    static std::size_t find(MsgIdType id)
+    {
+        return findInternal(id, std::integral_constant<bool, Direct>());
+    }
+
+private:
+    static constexpr std::size_t lowerBound(
+        MsgIdType id,
+        std::size_t from,
+        std::size_t to)
+    {
+        return (from == to) ?
+            from :
+            ((Ids[from + ((to - from) / 2)] < id) ?
+                lowerBound(id, from + ((to - from) / 2) + 1, to) :
+                lowerBound(id, from, from + ((to - from) / 2)));
+    }
+
+    static constexpr std::size_t indexAt(MsgIdType id, std::size_t idx)
+    {
+        return ((idx < NumOfMsgs) && (Ids[idx] == id)) ? idx : NumOfMsgs;
+    }
+
+    static constexpr std::size_t indexOf(MsgIdType id)
+    {
+        return indexAt(id, lowerBound(id, 0, NumOfMsgs));
+    }
+
+    template <std::size_t... TOffsets>
+    static std::size_t findDirect(
+        std::size_t offset,
+        util::IndexSequence<TOffsets...>)
+    {
+        typedef typename MsgIdxType<NumOfMsgs>::Type IndexType;
+        static const IndexType Table[Span] = {
+            static_cast<IndexType>(indexOf(static_cast<MsgIdType>(MinId + TOffsets)))...
+        };
+        return static_cast<std::size_t>(Table[offset]);
+    }
+
+    static std::size_t findInternal(MsgIdType id, std::true_type)
+    {
+        auto offset = static_cast<std::size_t>(id - MinId);
+        if ((id < MinId) || (Span <= offset)) {
+            return NumOfMsgs;
+        }
+
+        return findDirect(offset, typename util::MakeIndexSequence<Span>::Type());
+    }
+
+    static std::size_t findInternal(MsgIdType id, std::false_type)
+    {
+        return MsgIdHash<std::tuple_element<TIndices, TAllMessages>::type::MsgId...>::find(id);
+    }
+
+    static constexpr MsgIdType Ids[NumOfMsgs] = {
+        std::tuple_element<TIndices, TAllMessages>::type::MsgId...
+    };
+};
+
+template <typename TAllMessages, std::size_t... TIndices>
+constexpr traits::MsgIdType
+MsgIdTable<TAllMessages, util::IndexSequence<TIndices...> >::Ids[
+    MsgIdTable<TAllMessages, util::IndexSequence<TIndices...> >::NumOfMsgs];
+/// @endcond
+
+}  // namespace details
+
+}  // namespace comms
+
+}  // namespace embxx
@@ -0,0 +1,147 @@
+//
+// Copyright 2014 (C). Alex Robenko. All rights reserved.
+//
+
+// This library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file embxx/comms/StaticDispatch.h
+/// This file contains message dispatch functionality that doesn't require
+/// virtual message handler.
+
+#pragma once
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+
+#include "embxx/util/Tuple.h"
+#include "MsgIdTable.h"
+
+namespace embxx
+{
+
+namespace comms
+{
+
+namespace details
+{
+
+/// @cond DOCUMENT_STATIC_DISPATCHER
+template <typename TAllMessages, typename TMsgBase, typename THandler>
+class StaticDispatcher
+{
+    typedef MsgIdTable<TAllMessages> IdTable;
+
+    typedef typename util::MakeIndexSequence<
+        std::tuple_size<TAllMessages>::value>::Type Indices;
+
+public:
+    static bool dispatch(TMsgBase& msg, THandler& handler)
+    {
+        auto func = handleFunc(IdTable::find(msg.getId()), Indices());
+        if (func == nullptr) {
+            return false;
+        }
+
+        func(msg, handler);
+        return true;
+    }
+
+private:
+    typedef void (*HandleFunc)(TMsgBase& msg, THandler& handler);
+
+    template <typename TMessage>
+    static void handle(TMsgBase& msg, THandler& handler)
+    {
+        static_assert(std::is_base_of<TMsgBase, TMessage>::value,
+            "TMsgBase must be base class for all messages");
+
+        typedef typename std::conditional<
+            std::is_const<TMsgBase>::value,
+            const TMessage,
+            TMessage
+        >::type ActualMessage;
+
+        handler.handleMessage(static_cast<ActualMessage&>(msg));
+    }
+
+    template <std::size_t... TIndices>
+    static HandleFunc handleFunc(std::size_t idx, util::IndexSequence<TIndices...>)
+    {
+        // Last entry corresponds to unknown ID
+        static const HandleFunc Funcs[] = {
+            &StaticDispatcher::template handle<
+                typename std::tuple_element<TIndices, TAllMessages>::type>...,
+            nullptr
+        };
+        return Funcs[idx];
+    }
+};
+/// @endcond
+
+}  // namespace details
+
+/// @ingroup comms
+/// @brief Dispatch message to its handler without any virtual functions in
+///        the latter.
+/// @details Unlike Message::dispatch() which requires the handler to be
+///          derived from embxx::comms::MessageHandler and invokes the handling
+///          function using two virtual calls, this function looks up the
+///          actual type of the message by its ID in the table generated at
+///          compile time (see also embxx::comms::protocol::MsgIdLayer) and
+///          invokes non-virtual handling function of the handler, which may
+///          be inlined. Single handler may process all the message types
+///          using function template:
+///          @code
+///          struct MyHandler
+///          {
+///              template <typename TMsg>
+///              void handleMessage(TMsg& msg) {...}
+///          };
+///
+///          MyHandler handler;
+///          embxx::comms::dispatchStatic<AllMessages>(*msgPtr, handler);
+///          @endcode
+/// @tparam TAllMessages All message types bundled in std::tuple, sorted
+///         in ascending order based on their MsgId.
+/// @tparam TMsgBase Base class of all the messages in TAllMessages
+///         (deduced), may be const.
+/// @tparam THandler Handler class (deduced), must define handleMessage()
+///         member function for every message type in TAllMessages:
+///         @code void handleMessage(<message_type>& msg); @endcode
+///         or
+///         @code void handleMessage(const <message_type>& msg); @endcode
+///         when TMsgBase is const.
+/// @param[in] msg Message object
+/// @param[in] handler Handler object
+/// @return true if the message was dispatched, false if its ID doesn't
+///         belong to any message in TAllMessages.
+/// @pre TAllMessages is any variation of std::tuple
+/// @note Thread safety: Depends on thread safety of handler's code.
+/// @note Exception guarantee: Same as exception guarantee of the handler's
+///       code
+/// @headerfile embxx/comms/StaticDispatch.h
+template <typename TAllMessages, typename TMsgBase, typename THandler>
+bool dispatchStatic(TMsgBase& msg, THandler& handler)
+{
+    static_assert(util::IsTuple<TAllMessages>::Value,
+                  "TAllMessages must be std::tuple");
+
+    return details::StaticDispatcher<TAllMessages, TMsgBase, THandler>::dispatch(
+        msg, handler);
+}
+
+}  // namespace comms
+
+}  // namespace embxx
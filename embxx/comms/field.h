@@ -23,4 +23,8 @@
 #include "field/BasicIntValue.h"
 #include "field/BitmaskValue.h"
 #include "field/BasicEnumValue.h"
+#include "field/VarIntValue.h"
+#include "field/ArrayValue.h"
+#include "field/ArrayListValue.h"
+#include "field/StringValue.h"
 
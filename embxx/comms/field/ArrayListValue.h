@@ -0,0 +1,373 @@
+//
+// Copyright 2014 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file embxx/comms/field/ArrayListValue.h
+/// This file contains definition of length prefixed list field.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+#include "embxx/util/Assert.h"
+#include "embxx/util/SizeToType.h"
+#include "embxx/io/access.h"
+#include "embxx/comms/ErrorStatus.h"
+
+namespace embxx
+{
+
+namespace comms
+{
+
+namespace field
+{
+
+/// @addtogroup comms
+/// @{
+
+/// @brief Defines "Array List Value Field" containing variable number of
+///        integral elements.
+/// @details The number of elements is serialised first using TSizeLen
+///          bytes, followed by the elements, every one of which occupies
+///          sizeof(T) bytes. The endianness of both is specified in the
+///          traits. The elements are stored in the statically allocated
+///          array of TCapacity elements, the read operation fails with
+///          ErrorStatus::ProtocolError if the received list is longer.
+///          When the data resides in contiguous buffer (the iterator is a
+///          pointer to bytes), all the elements are copied at once and byte
+///          swapped if required (see embxx::io::readDataArray() and
+///          embxx::io::writeDataArray()).
+/// @tparam T Type of the element, must be integral type.
+/// @tparam TTraits Various behavioural traits relevant for the field.
+///         Currently the only trait that is required for this class is
+///         Endianness. The traits class/struct must typedef either
+///         embxx::comms::traits::endian::Big or
+///         embxx::comms::traits::endian::Little to Endianness.
+/// @tparam TCapacity Maximal number of elements.
+/// @tparam TSizeLen Length of serialised number of elements in bytes, the
+///         default value is 1.
+/// @headerfile embxx/comms/field/ArrayListValue.h
+template <typename T,
+          typename TTraits,
+          std::size_t TCapacity,
+          std::size_t TSizeLen = 1>
+class ArrayListValue
+{
+    static_assert(std::is_integral<T>::value, "T must be integral value");
+
+public:
+
+    /// @brief Type of single element
+    typedef T ElementType;
+
+    /// @brief Type of serialised number of elements
+    typedef typename util::SizeToType<TSizeLen>::Type SizeType;
+
+    /// @brief Field traits
+    typedef TTraits Traits;
+
+    /// @brief Data endianness
+    typedef typename Traits::Endianness Endianness;
+
+    /// @brief Maximal number of elements
+    static const std::size_t Capacity = TCapacity;
+
+    /// @brief Length of serialised number of elements
+    static const std::size_t SizeLen = TSizeLen;
+
+    static_assert(TCapacity <= std::numeric_limits<SizeType>::max(),
+        "The capacity is too big for TSizeLen");
+
+    /// @brief Default constructor
+    /// @details Creates empty list.
+    ArrayListValue();
+
+    /// @brief Constructor
+    /// @details Sets initial value.
+    /// @param values Pointer to the elements
+    /// @param count Number of elements
+    /// @pre count <= Capacity
+    ArrayListValue(const ElementType* values, std::size_t count);
+
+    /// @brief Copy constructor is default
+    ArrayListValue(const ArrayListValue&) = default;
+
+    /// @brief Destructor is default
+    ~ArrayListValue() = default;
+
+    /// @brief Copy assignment is default
+    ArrayListValue& operator=(const ArrayListValue&) = default;
+
+    /// @brief Get pointer to the first element.
+    const ElementType* data() const;
+
+    /// @copydoc data() const
+    ElementType* data();
+
+    /// @brief Get number of elements.
+    std::size_t size() const;
+
+    /// @brief Check whether the list is empty.
+    bool empty() const;
+
+    /// @brief Get maximal number of elements.
+    static constexpr std::size_t capacity();
+
+    /// @brief Access the element.
+    /// @pre idx < size()
+    const ElementType& operator[](std::size_t idx) const;
+
+    /// @copydoc operator[](std::size_t) const
+    ElementType& operator[](std::size_t idx);
+
+    /// @brief Remove all the elements.
+    void clear();
+
+    /// @brief Change number of elements, new elements are set to 0.
+    /// @pre count <= Capacity
+    void resize(std::size_t count);
+
+    /// @brief Add element to the end of the list.
+    /// @pre size() < Capacity
+    void pushBack(const ElementType& value);
+
+    /// @brief Replace all the elements.
+    /// @param values Pointer to the elements
+    /// @param count Number of elements
+    /// @pre count <= Capacity
+    void assign(const ElementType* values, std::size_t count);
+
+    /// @brief Get length of serialised data
+    std::size_t length() const;
+
+    /// @brief Read the serialised field value from the some data structure.
+    /// @tparam TIter Type of input iterator
+    /// @param[in, out] iter Input iterator.
+    /// @param[in] size Size of the data in iterated data structure.
+    /// @return Status of the read operation.
+    /// @pre Value of provided "size" must be less than or equal to
+    ///      available data in the used data structure/stream
+    /// @post The iterator will be incremented on success only.
+    template <typename TIter>
+    ErrorStatus read(TIter& iter, std::size_t size);
+
+    /// @brief Write the serialised field value to some data structure.
+    /// @tparam TIter Type of output iterator
+    /// @param[in, out] iter Output iterator.
+    /// @param[in] size Size of the buffer, field data must fit it.
+    /// @return Status of the write operation, ErrorStatus::BufferOverflow
+    ///         if the field data doesn't fit the buffer.
+    /// @pre Value of provided "size" must be less than or equal to
+    ///      available space in the data structure.
+    /// @post The iterator will be incremented on success only.
+    template <typename TIter>
+    ErrorStatus write(TIter& iter, std::size_t size) const;
+
+private:
+    std::array<ElementType, Capacity> values_;
+    std::size_t size_;
+};
+
+// Implementation
+
+/// @brief Equality comparison operator.
+/// @related ArrayListValue
+template <typename T, typename TTraits, std::size_t TCapacity, std::size_t TSizeLen>
+bool operator==(
+    const ArrayListValue<T, TTraits, TCapacity, TSizeLen>& field1,
+    const ArrayListValue<T, TTraits, TCapacity, TSizeLen>& field2)
+{
+    return
+        (field1.size() == field2.size()) &&
+        std::equal(field1.data(), field1.data() + field1.size(), field2.data());
+}
+
+/// @brief Non-equality comparison operator.
+/// @related ArrayListValue
+template <typename T, typename TTraits, std::size_t TCapacity, std::size_t TSizeLen>
+bool operator!=(
+    const ArrayListValue<T, TTraits, TCapacity, TSizeLen>& field1,
+    const ArrayListValue<T, TTraits, TCapacity, TSizeLen>& field2)
+{
+    return !(field1 == field2);
+}
+
+/// @}
+
+template <typename T, typename TTraits, std::size_t TCapacity, std::size_t TSizeLen>
+ArrayListValue<T, TTraits, TCapacity, TSizeLen>::ArrayListValue()
+    : values_(),
+      size_(0)
+{
+}
+
+template <typename T, typename TTraits, std::size_t TCapacity, std::size_t TSizeLen>
+ArrayListValue<T, TTraits, TCapacity, TSizeLen>::ArrayListValue(
+    const ElementType* values,
+    std::size_t count)
+    : values_(),
+      size_(0)
+{
+    assign(values, count);
+}
+
+template <typename T, typename TTraits, std::size_t TCapacity, std::size_t TSizeLen>
+const typename ArrayListValue<T, TTraits, TCapacity, TSizeLen>::ElementType*
+ArrayListValue<T, TTraits, TCapacity, TSizeLen>::data() const
+{
+    return values_.data();
+}
+
+template <typename T, typename TTraits, std::size_t TCapacity, std::size_t TSizeLen>
+typename ArrayListValue<T, TTraits, TCapacity, TSizeLen>::ElementType*
+ArrayListValue<T, TTraits, TCapacity, TSizeLen>::data()
+{
+    return values_.data();
+}
+
+template <typename T, typename TTraits, std::size_t TCapacity, std::size_t TSizeLen>
+std::size_t ArrayListValue<T, TTraits, TCapacity, TSizeLen>::size() const
+{
+    return size_;
+}
+
+template <typename T, typename TTraits, std::size_t TCapacity, std::size_t TSizeLen>
+bool ArrayListValue<T, TTraits, TCapacity, TSizeLen>::empty() const
+{
+    return size_ == 0;
+}
+
+template <typename T, typename TTraits, std::size_t TCapacity, std::size_t TSizeLen>
+constexpr std::size_t ArrayListValue<T, TTraits, TCapacity, TSizeLen>::capacity()
+{
+    return Capacity;
+}
+
+template <typename T, typename TTraits, std::size_t TCapacity, std::size_t TSizeLen>
+const typename ArrayListValue<T, TTraits, TCapacity, TSizeLen>::ElementType&
+ArrayListValue<T, TTraits, TCapacity, TSizeLen>::operator[](std::size_t idx) const
+{
+    GASSERT(idx < size_);
+    return values_[idx];
+}
+
+template <typename T, typename TTraits, std::size_t TCapacity, std::size_t TSizeLen>
+typename ArrayListValue<T, TTraits, TCapacity, TSizeLen>::ElementType&
+ArrayListValue<T, TTraits, TCapacity, TSizeLen>::operator[](std::size_t idx)
+{
+    GASSERT(idx < size_);
+    return values_[idx];
+}
+
+template <typename T, typename TTraits, std::size_t TCapacity, std::size_t TSizeLen>
+void ArrayListValue<T, TTraits, TCapacity, TSizeLen>::clear()
+{
+    size_ = 0;
+}
+
+template <typename T, typename TTraits, std::size_t TCapacity, std::size_t TSizeLen>
+void ArrayListValue<T, TTraits, TCapacity, TSizeLen>::resize(std::size_t count)
+{
+    GASSERT(count <= Capacity);
+    count = (count < Capacity) ? count : Capacity;
+    if (size_ < count) {
+        std::fill(values_.begin() + size_, values_.begin() + count, static_cast<ElementType>(0));
+    }
+    size_ = count;
+}
+
+template <typename T, typename TTraits, std::size_t TCapacity, std::size_t TSizeLen>
+void ArrayListValue<T, TTraits, TCapacity, TSizeLen>::pushBack(const ElementType& value)
+{
+    GASSERT(size_ < Capacity);
+    if (Capacity <= size_) {
+        return;
+    }
+
+    values_[size_] = value;
+    ++size_;
+}
+
+template <typename T, typename TTraits, std::size_t TCapacity, std::size_t TSizeLen>
+void ArrayListValue<T, TTraits, TCapacity, TSizeLen>::assign(
+    const ElementType* values,
+    std::size_t count)
+{
+    GASSERT(count <= Capacity);
+    size_ = (count < Capacity) ? count : Capacity;
+    std::copy(values, values + size_, values_.begin());
+}
+
+template <typename T, typename TTraits, std::size_t TCapacity, std::size_t TSizeLen>
+std::size_t ArrayListValue<T, TTraits, TCapacity, TSizeLen>::length() const
+{
+    return SizeLen + (size_ * sizeof(ElementType));
+}
+
+template <typename T, typename TTraits, std::size_t TCapacity, std::size_t TSizeLen>
+template <typename TIter>
+ErrorStatus ArrayListValue<T, TTraits, TCapacity, TSizeLen>::read(
+    TIter& iter,
+    std::size_t size)
+{
+    if (size < SizeLen) {
+        return ErrorStatus::NotEnoughData;
+    }
+
+    auto readIter = iter;
+    auto count =
+        static_cast<std::size_t>(
+            io::readData<SizeType, SizeLen>(readIter, Endianness()));
+
+    if (Capacity < count) {
+        return ErrorStatus::ProtocolError;
+    }
+
+    if ((size - SizeLen) < (count * sizeof(ElementType))) {
+        return ErrorStatus::NotEnoughData;
+    }
+
+    io::readDataArray(values_.data(), count, readIter, Endianness());
+    size_ = count;
+    iter = readIter;
+    return ErrorStatus::Success;
+}
+
+template <typename T, typename TTraits, std::size_t TCapacity, std::size_t TSizeLen>
+template <typename TIter>
+ErrorStatus ArrayListValue<T, TTraits, TCapacity, TSizeLen>::write(
+    TIter& iter,
+    std::size_t size) const
+{
+    if (size < length()) {
+        return ErrorStatus::BufferOverflow;
+    }
+
+    io::writeData<SizeLen>(static_cast<SizeType>(size_), iter, Endianness());
+    io::writeDataArray(values_.data(), size_, iter, Endianness());
+    return ErrorStatus::Success;
+}
+
+}  // namespace field
+
+}  // namespace comms
+
+}  // namespace embxx
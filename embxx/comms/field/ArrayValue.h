@@ -0,0 +1,236 @@
+//
+// Copyright 2014 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file embxx/comms/field/ArrayValue.h
+/// This file contains definition of fixed size array field.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+#include "embxx/io/access.h"
+#include "embxx/comms/ErrorStatus.h"
+
+namespace embxx
+{
+
+namespace comms
+{
+
+namespace field
+{
+
+/// @addtogroup comms
+/// @{
+
+/// @brief Defines "Array Value Field" containing fixed number of integral
+///        elements.
+/// @details Every element is serialised using sizeof(T) bytes with
+///          endianness specified in the traits. When the data resides in
+///          contiguous buffer (the iterator is a pointer to bytes), all the
+///          elements are copied at once and byte swapped if required
+///          (see embxx::io::readDataArray() and embxx::io::writeDataArray()).
+/// @tparam T Type of the element, must be integral type.
+/// @tparam TTraits Various behavioural traits relevant for the field.
+///         Currently the only trait that is required for this class is
+///         Endianness. The traits class/struct must typedef either
+///         embxx::comms::traits::endian::Big or
+///         embxx::comms::traits::endian::Little to Endianness.
+/// @tparam TSize Number of elements.
+/// @headerfile embxx/comms/field/ArrayValue.h
+template <typename T,
+          typename TTraits,
+          std::size_t TSize>
+class ArrayValue
+{
+    static_assert(std::is_integral<T>::value, "T must be integral value");
+
+public:
+
+    /// @brief Type of single element
+    typedef T ElementType;
+
+    /// @brief Value Type
+    typedef std::array<ElementType, TSize> ValueType;
+
+    /// @brief Field traits
+    typedef TTraits Traits;
+
+    /// @brief Data endianness
+    typedef typename Traits::Endianness Endianness;
+
+    /// @brief Number of elements
+    static const std::size_t NumOfElements = TSize;
+
+    /// @brief Length of serialised data
+    static const std::size_t SerialisedLen = TSize * sizeof(ElementType);
+
+    /// @brief Default constructor
+    /// @details Sets all the elements to 0.
+    ArrayValue();
+
+    /// @brief Constructor
+    /// @details Sets initial value.
+    /// @param value Initial value
+    explicit ArrayValue(const ValueType& value);
+
+    /// @brief Copy constructor is default
+    ArrayValue(const ArrayValue&) = default;
+
+    /// @brief Destructor is default
+    ~ArrayValue() = default;
+
+    /// @brief Copy assignment is default
+    ArrayValue& operator=(const ArrayValue&) = default;
+
+    /// @brief Retrieve the value.
+    const ValueType& getValue() const;
+
+    /// @brief Set the value
+    /// @param value Value to set.
+    void setValue(const ValueType& value);
+
+    /// @brief Get access to the stored elements for in place update.
+    ValueType& value();
+
+    /// @brief Get length of serialised data
+    static constexpr std::size_t length();
+
+    /// @brief Read the serialised field value from the some data structure.
+    /// @tparam TIter Type of input iterator
+    /// @param[in, out] iter Input iterator.
+    /// @param[in] size Size of the data in iterated data structure.
+    /// @return Status of the read operation.
+    /// @pre Value of provided "size" must be less than or equal to
+    ///      available data in the used data structure/stream
+    /// @post The iterator will be incremented.
+    template <typename TIter>
+    ErrorStatus read(TIter& iter, std::size_t size);
+
+    /// @brief Write the serialised field value to some data structure.
+    /// @tparam TIter Type of output iterator
+    /// @param[in, out] iter Output iterator.
+    /// @param[in] size Size of the buffer, field data must fit it.
+    /// @return Status of the write operation, ErrorStatus::BufferOverflow
+    ///         if the field data doesn't fit the buffer.
+    /// @pre Value of provided "size" must be less than or equal to
+    ///      available space in the data structure.
+    /// @post The iterator will be incremented on success only.
+    template <typename TIter>
+    ErrorStatus write(TIter& iter, std::size_t size) const;
+
+private:
+    ValueType value_;
+};
+
+// Implementation
+
+/// @brief Equality comparison operator.
+/// @related ArrayValue
+template <typename T, typename TTraits, std::size_t TSize>
+bool operator==(
+    const ArrayValue<T, TTraits, TSize>& field1,
+    const ArrayValue<T, TTraits, TSize>& field2)
+{
+    return field1.getValue() == field2.getValue();
+}
+
+/// @brief Non-equality comparison operator.
+/// @related ArrayValue
+template <typename T, typename TTraits, std::size_t TSize>
+bool operator!=(
+    const ArrayValue<T, TTraits, TSize>& field1,
+    const ArrayValue<T, TTraits, TSize>& field2)
+{
+    return field1.getValue() != field2.getValue();
+}
+
+/// @}
+
+template <typename T, typename TTraits, std::size_t TSize>
+ArrayValue<T, TTraits, TSize>::ArrayValue()
+    : value_()
+{
+}
+
+template <typename T, typename TTraits, std::size_t TSize>
+ArrayValue<T, TTraits, TSize>::ArrayValue(const ValueType& value)
+    : value_(value)
+{
+}
+
+template <typename T, typename TTraits, std::size_t TSize>
+const typename ArrayValue<T, TTraits, TSize>::ValueType&
+ArrayValue<T, TTraits, TSize>::getValue() const
+{
+    return value_;
+}
+
+template <typename T, typename TTraits, std::size_t TSize>
+void ArrayValue<T, TTraits, TSize>::setValue(const ValueType& value)
+{
+    value_ = value;
+}
+
+template <typename T, typename TTraits, std::size_t TSize>
+typename ArrayValue<T, TTraits, TSize>::ValueType&
+ArrayValue<T, TTraits, TSize>::value()
+{
+    return value_;
+}
+
+template <typename T, typename TTraits, std::size_t TSize>
+constexpr std::size_t ArrayValue<T, TTraits, TSize>::length()
+{
+    return SerialisedLen;
+}
+
+template <typename T, typename TTraits, std::size_t TSize>
+template <typename TIter>
+ErrorStatus ArrayValue<T, TTraits, TSize>::read(
+    TIter& iter,
+    std::size_t size)
+{
+    if (size < length()) {
+        return ErrorStatus::NotEnoughData;
+    }
+
+    io::readDataArray(value_.data(), NumOfElements, iter, Endianness());
+    return ErrorStatus::Success;
+}
+
+template <typename T, typename TTraits, std::size_t TSize>
+template <typename TIter>
+ErrorStatus ArrayValue<T, TTraits, TSize>::write(
+    TIter& iter,
+    std::size_t size) const
+{
+    if (size < length()) {
+        return ErrorStatus::BufferOverflow;
+    }
+
+    io::writeDataArray(value_.data(), NumOfElements, iter, Endianness());
+    return ErrorStatus::Success;
+}
+
+}  // namespace field
+
+}  // namespace comms
+
+}  // namespace embxx
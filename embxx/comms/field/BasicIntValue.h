@@ -137,10 +137,11 @@ public:
     /// @tparam TIter Type of output iterator
     /// @param[in, out] iter Output iterator.
     /// @param[in] size Size of the buffer, field data must fit it.
-    /// @return Status of the write operation.
+    /// @return Status of the write operation, ErrorStatus::BufferOverflow
+    ///         if the field data doesn't fit the buffer.
     /// @pre Value of provided "size" must be less than or equal to
     ///      available space in the data structure.
-    /// @post The iterator will be incremented.
+    /// @post The iterator will be incremented on success only.
     template <typename TIter>
     ErrorStatus write(TIter& iter, std::size_t size) const;
 
@@ -310,8 +311,9 @@ ErrorStatus BasicIntValue<T, TTraits, TLen, TOff>::write(
     TIter& iter,
     std::size_t size) const
 {
-    GASSERT(length() <= size);
-    static_cast<void>(size);
+    if (size < length()) {
+        return ErrorStatus::BufferOverflow;
+    }
 
     io::writeData<SerialisedLen>(getSerialisedValue(), iter, Endianness());
     return ErrorStatus::Success;
@@ -0,0 +1,300 @@
+//
+// Copyright 2014 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file embxx/comms/field/StringValue.h
+/// This file contains definition of length prefixed string field.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+
+#include "embxx/util/Assert.h"
+#include "embxx/util/SizeToType.h"
+#include "embxx/io/access.h"
+#include "embxx/comms/ErrorStatus.h"
+
+namespace embxx
+{
+
+namespace comms
+{
+
+namespace field
+{
+
+/// @addtogroup comms
+/// @{
+
+/// @brief Defines "String Value Field".
+/// @details The length of the string is serialised first using TSizeLen
+///          bytes with endianness specified in the traits, followed by the
+///          characters without terminating zero. The characters are stored
+///          in the statically allocated buffer of TCapacity + 1 bytes, which
+///          is always zero terminated. The read operation fails with
+///          ErrorStatus::ProtocolError if the received string is longer than
+///          TCapacity. When the data resides in contiguous buffer (the
+///          iterator is a pointer to bytes), the characters are copied
+///          with single std::memcpy.
+/// @tparam TTraits Various behavioural traits relevant for the field.
+///         Currently the only trait that is required for this class is
+///         Endianness. The traits class/struct must typedef either
+///         embxx::comms::traits::endian::Big or
+///         embxx::comms::traits::endian::Little to Endianness.
+/// @tparam TCapacity Maximal length of the string.
+/// @tparam TSizeLen Length of serialised string length in bytes, the default
+///         value is 1.
+/// @headerfile embxx/comms/field/StringValue.h
+template <typename TTraits,
+          std::size_t TCapacity,
+          std::size_t TSizeLen = 1>
+class StringValue
+{
+public:
+
+    /// @brief Type of serialised string length
+    typedef typename util::SizeToType<TSizeLen>::Type SizeType;
+
+    /// @brief Field traits
+    typedef TTraits Traits;
+
+    /// @brief Data endianness
+    typedef typename Traits::Endianness Endianness;
+
+    /// @brief Maximal length of the string
+    static const std::size_t Capacity = TCapacity;
+
+    /// @brief Length of serialised string length
+    static const std::size_t SizeLen = TSizeLen;
+
+    static_assert(TCapacity <= std::numeric_limits<SizeType>::max(),
+        "The capacity is too big for TSizeLen");
+
+    /// @brief Default constructor
+    /// @details Creates empty string.
+    StringValue();
+
+    /// @brief Constructor
+    /// @details Sets initial value.
+    /// @param str Zero terminated string
+    /// @pre std::strlen(str) <= Capacity
+    explicit StringValue(const char* str);
+
+    /// @brief Copy constructor is default
+    StringValue(const StringValue&) = default;
+
+    /// @brief Destructor is default
+    ~StringValue() = default;
+
+    /// @brief Copy assignment is default
+    StringValue& operator=(const StringValue&) = default;
+
+    /// @brief Retrieve the value as zero terminated string.
+    const char* getValue() const;
+
+    /// @brief Set the value
+    /// @param str Zero terminated string
+    /// @pre std::strlen(str) <= Capacity
+    void setValue(const char* str);
+
+    /// @brief Set the value
+    /// @param str Pointer to the characters
+    /// @param len Number of the characters
+    /// @pre len <= Capacity
+    void setValue(const char* str, std::size_t len);
+
+    /// @brief Get length of the string.
+    std::size_t size() const;
+
+    /// @brief Check whether the string is empty.
+    bool empty() const;
+
+    /// @brief Get maximal length of the string.
+    static constexpr std::size_t capacity();
+
+    /// @brief Get length of serialised data
+    std::size_t length() const;
+
+    /// @brief Read the serialised field value from the some data structure.
+    /// @tparam TIter Type of input iterator
+    /// @param[in, out] iter Input iterator.
+    /// @param[in] size Size of the data in iterated data structure.
+    /// @return Status of the read operation.
+    /// @pre Value of provided "size" must be less than or equal to
+    ///      available data in the used data structure/stream
+    /// @post The iterator will be incremented on success only.
+    template <typename TIter>
+    ErrorStatus read(TIter& iter, std::size_t size);
+
+    /// @brief Write the serialised field value to some data structure.
+    /// @tparam TIter Type of output iterator
+    /// @param[in, out] iter Output iterator.
+    /// @param[in] size Size of the buffer, field data must fit it.
+    /// @return Status of the write operation, ErrorStatus::BufferOverflow
+    ///         if the field data doesn't fit the buffer.
+    /// @pre Value of provided "size" must be less than or equal to
+    ///      available space in the data structure.
+    /// @post The iterator will be incremented on success only.
+    template <typename TIter>
+    ErrorStatus write(TIter& iter, std::size_t size) const;
+
+private:
+    char str_[Capacity + 1];
+    std::size_t size_;
+};
+
+// Implementation
+
+/// @brief Equality comparison operator.
+/// @related StringValue
+template <typename TTraits, std::size_t TCapacity, std::size_t TSizeLen>
+bool operator==(
+    const StringValue<TTraits, TCapacity, TSizeLen>& field1,
+    const StringValue<TTraits, TCapacity, TSizeLen>& field2)
+{
+    return
+        (field1.size() == field2.size()) &&
+        std::equal(field1.getValue(), field1.getValue() + field1.size(), field2.getValue());
+}
+
+/// @brief Non-equality comparison operator.
+/// @related StringValue
+template <typename TTraits, std::size_t TCapacity, std::size_t TSizeLen>
+bool operator!=(
+    const StringValue<TTraits, TCapacity, TSizeLen>& field1,
+    const StringValue<TTraits, TCapacity, TSizeLen>& field2)
+{
+    return !(field1 == field2);
+}
+
+/// @}
+
+template <typename TTraits, std::size_t TCapacity, std::size_t TSizeLen>
+StringValue<TTraits, TCapacity, TSizeLen>::StringValue()
+    : str_(),
+      size_(0)
+{
+}
+
+template <typename TTraits, std::size_t TCapacity, std::size_t TSizeLen>
+StringValue<TTraits, TCapacity, TSizeLen>::StringValue(const char* str)
+    : str_(),
+      size_(0)
+{
+    setValue(str);
+}
+
+template <typename TTraits, std::size_t TCapacity, std::size_t TSizeLen>
+const char* StringValue<TTraits, TCapacity, TSizeLen>::getValue() const
+{
+    return &str_[0];
+}
+
+template <typename TTraits, std::size_t TCapacity, std::size_t TSizeLen>
+void StringValue<TTraits, TCapacity, TSizeLen>::setValue(const char* str)
+{
+    GASSERT(str != nullptr);
+    setValue(str, std::strlen(str));
+}
+
+template <typename TTraits, std::size_t TCapacity, std::size_t TSizeLen>
+void StringValue<TTraits, TCapacity, TSizeLen>::setValue(
+    const char* str,
+    std::size_t len)
+{
+    GASSERT(len <= Capacity);
+    size_ = (len < Capacity) ? len : Capacity;
+    std::copy(str, str + size_, &str_[0]);
+    str_[size_] = '\0';
+}
+
+template <typename TTraits, std::size_t TCapacity, std::size_t TSizeLen>
+std::size_t StringValue<TTraits, TCapacity, TSizeLen>::size() const
+{
+    return size_;
+}
+
+template <typename TTraits, std::size_t TCapacity, std::size_t TSizeLen>
+bool StringValue<TTraits, TCapacity, TSizeLen>::empty() const
+{
+    return size_ == 0;
+}
+
+template <typename TTraits, std::size_t TCapacity, std::size_t TSizeLen>
+constexpr std::size_t StringValue<TTraits, TCapacity, TSizeLen>::capacity()
+{
+    return Capacity;
+}
+
+template <typename TTraits, std::size_t TCapacity, std::size_t TSizeLen>
+std::size_t StringValue<TTraits, TCapacity, TSizeLen>::length() const
+{
+    return SizeLen + size_;
+}
+
+template <typename TTraits, std::size_t TCapacity, std::size_t TSizeLen>
+template <typename TIter>
+ErrorStatus StringValue<TTraits, TCapacity, TSizeLen>::read(
+    TIter& iter,
+    std::size_t size)
+{
+    if (size < SizeLen) {
+        return ErrorStatus::NotEnoughData;
+    }
+
+    auto readIter = iter;
+    auto len =
+        static_cast<std::size_t>(
+            io::readData<SizeType, SizeLen>(readIter, Endianness()));
+
+    if (Capacity < len) {
+        return ErrorStatus::ProtocolError;
+    }
+
+    if ((size - SizeLen) < len) {
+        return ErrorStatus::NotEnoughData;
+    }
+
+    io::readDataArray(&str_[0], len, readIter, Endianness());
+    str_[len] = '\0';
+    size_ = len;
+    iter = readIter;
+    return ErrorStatus::Success;
+}
+
+template <typename TTraits, std::size_t TCapacity, std::size_t TSizeLen>
+template <typename TIter>
+ErrorStatus StringValue<TTraits, TCapacity, TSizeLen>::write(
+    TIter& iter,
+    std::size_t size) const
+{
+    if (size < length()) {
+        return ErrorStatus::BufferOverflow;
+    }
+
+    io::writeData<SizeLen>(static_cast<SizeType>(size_), iter, Endianness());
+    io::writeDataArray(&str_[0], size_, iter, Endianness());
+    return ErrorStatus::Success;
+}
+
+}  // namespace field
+
+}  // namespace comms
+
+}  // namespace embxx
@@ -0,0 +1,513 @@
+//
+// Copyright 2014 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file embxx/comms/field/VarIntValue.h
+/// This file contains definition of variable length integer field.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "embxx/util/Assert.h"
+#include "embxx/io/access.h"
+#include "embxx/comms/ErrorStatus.h"
+
+namespace embxx
+{
+
+namespace comms
+{
+
+namespace field
+{
+
+namespace varint_details
+{
+
+/// @cond DOCUMENT_VAR_INT_DETAILS
+inline std::size_t encodedLength(std::uint64_t value)
+{
+#ifdef __GNUC__
+    auto bits =
+        static_cast<std::size_t>(64 - __builtin_clzll(value | 1U));
+    return (bits + 6) / 7;
+#else // #ifdef __GNUC__
+    std::size_t len = 1;
+    while (0x80 <= value) {
+        value >>= 7;
+        ++len;
+    }
+    return len;
+#endif // #ifdef __GNUC__
+}
+
+template <typename TIter>
+ErrorStatus decode(
+    TIter& iter,
+    std::size_t size,
+    std::size_t maxLen,
+    std::uint64_t& value)
+{
+    std::uint64_t result = 0;
+    auto limit = (size < maxLen) ? size : maxLen;
+    for (std::size_t idx = 0; idx < limit; ++idx) {
+        auto byte = embxx::io::readBig<std::uint8_t>(iter);
+        auto bits = static_cast<std::uint64_t>(byte & 0x7f);
+        auto shift = idx * 7;
+        if ((63 <= shift) && (1U < bits)) {
+            return ErrorStatus::ProtocolError;
+        }
+
+        result |= (bits << shift);
+        if ((byte & 0x80) == 0) {
+            value = result;
+            return ErrorStatus::Success;
+        }
+    }
+
+    if (size < maxLen) {
+        return ErrorStatus::NotEnoughData;
+    }
+    return ErrorStatus::ProtocolError;
+}
+
+// Decodes value of up to 8 bytes from 8 bytes word without any loops,
+// returns 0 if the value is longer.
+inline std::size_t decodeWord(const std::uint8_t* bytes, std::uint64_t& value)
+{
+    auto word = embxx::io::readLittle<std::uint64_t>(bytes);
+    auto stopBits = (~word) & 0x8080808080808080ULL;
+    if (stopBits == 0) {
+        return 0;
+    }
+
+#ifdef __GNUC__
+    auto len = static_cast<std::size_t>(__builtin_ctzll(stopBits) + 1) / 8;
+#else // #ifdef __GNUC__
+    std::size_t len = 1;
+    while ((stopBits & 0x80) == 0) {
+        stopBits >>= 8;
+        ++len;
+    }
+#endif // #ifdef __GNUC__
+
+    auto bits =
+        word &
+        0x7f7f7f7f7f7f7f7fULL &
+        ((~static_cast<std::uint64_t>(0)) >> (64 - (len * 8)));
+    bits = ((bits & 0x7f007f007f007f00ULL) >> 1) | (bits & 0x007f007f007f007fULL);
+    bits = ((bits & 0x3fff00003fff0000ULL) >> 2) | (bits & 0x00003fff00003fffULL);
+    bits = ((bits & 0x0fffffff00000000ULL) >> 4) | (bits & 0x000000000fffffffULL);
+    value = bits;
+    return len;
+}
+/// @endcond
+
+}  // namespace varint_details
+
+/// @addtogroup comms
+/// @{
+
+/// @brief Defines "Variable Length Integer Value Field".
+/// @details The value is serialised using base 128 (LEB128) encoding: seven
+///          bits of the value per byte, least significant group first, with
+///          the most significant bit of every byte except the last one set.
+///          Small values occupy single byte regardless of the value type.
+///          When zigzag encoding is enabled (default for signed types),
+///          small negative values are also serialised using few bytes:
+///          0 -> 0, -1 -> 1, 1 -> 2, -2 -> 3, etc...
+///
+///          Unlike BasicIntValue, the length of the serialised data depends
+///          on the value, so length() is not static. When the data resides
+///          in contiguous buffer (the iterator is a pointer to bytes) and
+///          there are at least 8 bytes available, the value of up to 8 bytes
+///          is decoded from single 8 bytes load without per byte loop.
+/// @tparam T Type of the value, must be integral type.
+/// @tparam TTraits Various behavioural traits relevant for the field. The
+///         endianness of the encoding is fixed, the traits are accepted for
+///         consistency with other fields.
+/// @tparam TZigZag Use zigzag encoding, defaults to true for signed types.
+/// @headerfile embxx/comms/field/VarIntValue.h
+template <typename T,
+          typename TTraits,
+          bool TZigZag = std::is_signed<T>::value>
+class VarIntValue
+{
+    static_assert(std::is_integral<T>::value, "T must be integral value");
+    static_assert(sizeof(T) <= sizeof(std::uint64_t), "T is too big");
+
+public:
+
+    /// @brief Value Type
+    typedef T ValueType;
+
+    /// @brief Serialised Type
+    typedef typename std::make_unsigned<T>::type SerialisedType;
+
+    /// @brief Field traits
+    typedef TTraits Traits;
+
+    /// @brief Whether zigzag encoding is used
+    static const bool ZigZag = TZigZag;
+
+    /// @brief Minimal length of serialised data
+    static const std::size_t MinLength = 1;
+
+    /// @brief Maximal length of serialised data
+    static const std::size_t MaxLength =
+        ((std::numeric_limits<SerialisedType>::digits + 6) / 7);
+
+    /// @brief Default constructor
+    /// @details Sets default value to be 0.
+    VarIntValue();
+
+    /// @brief Constructor
+    /// @details Sets initial value.
+    /// @param value Initial value
+    explicit VarIntValue(ValueType value);
+
+    /// @brief Copy constructor is default
+    VarIntValue(const VarIntValue&) = default;
+
+    /// @brief Destructor is default
+    ~VarIntValue() = default;
+
+    /// @brief Copy assignment is default
+    VarIntValue& operator=(const VarIntValue&) = default;
+
+    /// @brief Retrieve the value.
+    const ValueType getValue() const;
+
+    /// @brief Set the value
+    /// @param value Value to set.
+    void setValue(ValueType value);
+
+    /// @brief Retrieve serialised data (zigzag encoded if applicable)
+    const SerialisedType getSerialisedValue() const;
+
+    /// @brief Set serialised data (zigzag encoded if applicable)
+    void setSerialisedValue(SerialisedType value);
+
+    /// @brief Convert value to serialised data
+    static constexpr const SerialisedType toSerialised(ValueType value);
+
+    /// @brief Convert serialised data to actual value
+    static constexpr const ValueType fromSerialised(SerialisedType value);
+
+    /// @brief Get length of serialised data of the current value
+    std::size_t length() const;
+
+    /// @brief Read the serialised field value from the some data structure.
+    /// @tparam TIter Type of input iterator
+    /// @param[in, out] iter Input iterator.
+    /// @param[in] size Size of the data in iterated data structure.
+    /// @return Status of the read operation: ErrorStatus::NotEnoughData
+    ///         if the data ends before the last byte of the value,
+    ///         ErrorStatus::ProtocolError if the value is longer than
+    ///         MaxLength or doesn't fit into ValueType.
+    /// @pre Value of provided "size" must be less than or equal to
+    ///      available data in the used data structure/stream
+    /// @post The iterator will be incremented on success only.
+    template <typename TIter>
+    ErrorStatus read(TIter& iter, std::size_t size);
+
+    /// @brief Write the serialised field value to some data structure.
+    /// @tparam TIter Type of output iterator
+    /// @param[in, out] iter Output iterator.
+    /// @param[in] size Size of the buffer, field data must fit it.
+    /// @return Status of the write operation, ErrorStatus::BufferOverflow
+    ///         if the field data doesn't fit the buffer.
+    /// @pre Value of provided "size" must be less than or equal to
+    ///      available space in the data structure.
+    /// @post The iterator will be incremented on success only.
+    template <typename TIter>
+    ErrorStatus write(TIter& iter, std::size_t size) const;
+
+private:
+    static constexpr const SerialisedType toSerialisedInternal(
+        ValueType value,
+        std::true_type);
+
+    static constexpr const SerialisedType toSerialisedInternal(
+        ValueType value,
+        std::false_type);
+
+    static constexpr const ValueType fromSerialisedInternal(
+        SerialisedType value,
+        std::true_type);
+
+    static constexpr const ValueType fromSerialisedInternal(
+        SerialisedType value,
+        std::false_type);
+
+    template <typename TIter>
+    ErrorStatus readInternal(TIter& iter, std::size_t size, std::true_type);
+
+    template <typename TIter>
+    ErrorStatus readInternal(TIter& iter, std::size_t size, std::false_type);
+
+    ErrorStatus assignDecoded(std::uint64_t value);
+
+    ValueType value_;
+};
+
+// Implementation
+
+/// @brief Equality comparison operator.
+/// @related VarIntValue
+template <typename T, typename TTraits, bool TZigZag>
+bool operator==(
+    const VarIntValue<T, TTraits, TZigZag>& field1,
+    const VarIntValue<T, TTraits, TZigZag>& field2)
+{
+    return field1.getValue() == field2.getValue();
+}
+
+/// @brief Non-equality comparison operator.
+/// @related VarIntValue
+template <typename T, typename TTraits, bool TZigZag>
+bool operator!=(
+    const VarIntValue<T, TTraits, TZigZag>& field1,
+    const VarIntValue<T, TTraits, TZigZag>& field2)
+{
+    return field1.getValue() != field2.getValue();
+}
+
+/// @brief Equivalence comparison operator.
+/// @related VarIntValue
+template <typename T, typename TTraits, bool TZigZag>
+bool operator<(
+    const VarIntValue<T, TTraits, TZigZag>& field1,
+    const VarIntValue<T, TTraits, TZigZag>& field2)
+{
+    return field1.getValue() < field2.getValue();
+}
+
+/// @}
+
+template <typename T, typename TTraits, bool TZigZag>
+VarIntValue<T, TTraits, TZigZag>::VarIntValue()
+    : value_(static_cast<ValueType>(0))
+{
+}
+
+template <typename T, typename TTraits, bool TZigZag>
+VarIntValue<T, TTraits, TZigZag>::VarIntValue(ValueType value)
+    : value_(value)
+{
+}
+
+template <typename T, typename TTraits, bool TZigZag>
+const typename VarIntValue<T, TTraits, TZigZag>::ValueType
+VarIntValue<T, TTraits, TZigZag>::getValue() const
+{
+    return value_;
+}
+
+template <typename T, typename TTraits, bool TZigZag>
+void VarIntValue<T, TTraits, TZigZag>::setValue(ValueType value)
+{
+    value_ = value;
+}
+
+template <typename T, typename TTraits, bool TZigZag>
+const typename VarIntValue<T, TTraits, TZigZag>::SerialisedType
+VarIntValue<T, TTraits, TZigZag>::getSerialisedValue() const
+{
+    return toSerialised(value_);
+}
+
+template <typename T, typename TTraits, bool TZigZag>
+void VarIntValue<T, TTraits, TZigZag>::setSerialisedValue(SerialisedType value)
+{
+    value_ = fromSerialised(value);
+}
+
+template <typename T, typename TTraits, bool TZigZag>
+constexpr
+const typename VarIntValue<T, TTraits, TZigZag>::SerialisedType
+VarIntValue<T, TTraits, TZigZag>::toSerialised(ValueType value)
+{
+    return toSerialisedInternal(value, std::integral_constant<bool, ZigZag>());
+}
+
+template <typename T, typename TTraits, bool TZigZag>
+constexpr
+const typename VarIntValue<T, TTraits, TZigZag>::ValueType
+VarIntValue<T, TTraits, TZigZag>::fromSerialised(SerialisedType value)
+{
+    return fromSerialisedInternal(value, std::integral_constant<bool, ZigZag>());
+}
+
+template <typename T, typename TTraits, bool TZigZag>
+std::size_t VarIntValue<T, TTraits, TZigZag>::length() const
+{
+    return varint_details::encodedLength(getSerialisedValue());
+}
+
+template <typename T, typename TTraits, bool TZigZag>
+template <typename TIter>
+ErrorStatus VarIntValue<T, TTraits, TZigZag>::read(
+    TIter& iter,
+    std::size_t size)
+{
+    if (size < MinLength) {
+        return ErrorStatus::NotEnoughData;
+    }
+
+    typedef std::integral_constant<
+        bool,
+        io::IsByteBuffer<TIter>::Value> Tag;
+    return readInternal(iter, size, Tag());
+}
+
+template <typename T, typename TTraits, bool TZigZag>
+template <typename TIter>
+ErrorStatus VarIntValue<T, TTraits, TZigZag>::write(
+    TIter& iter,
+    std::size_t size) const
+{
+    if (size < length()) {
+        return ErrorStatus::BufferOverflow;
+    }
+
+    auto value = getSerialisedValue();
+    while (0x80 <= value) {
+        embxx::io::writeBig(static_cast<std::uint8_t>(value | 0x80), iter);
+        value = static_cast<SerialisedType>(value >> 7);
+    }
+    embxx::io::writeBig(static_cast<std::uint8_t>(value), iter);
+    return ErrorStatus::Success;
+}
+
+template <typename T, typename TTraits, bool TZigZag>
+constexpr
+const typename VarIntValue<T, TTraits, TZigZag>::SerialisedType
+VarIntValue<T, TTraits, TZigZag>::toSerialisedInternal(
+    ValueType value,
+    std::true_type)
+{
+    return static_cast<SerialisedType>(
+        (static_cast<SerialisedType>(value) << 1) ^
+        static_cast<SerialisedType>(
+            (value < 0) ? std::numeric_limits<SerialisedType>::max() : 0));
+}
+
+template <typename T, typename TTraits, bool TZigZag>
+constexpr
+const typename VarIntValue<T, TTraits, TZigZag>::SerialisedType
+VarIntValue<T, TTraits, TZigZag>::toSerialisedInternal(
+    ValueType value,
+    std::false_type)
+{
+    return static_cast<SerialisedType>(value);
+}
+
+template <typename T, typename TTraits, bool TZigZag>
+constexpr
+const typename VarIntValue<T, TTraits, TZigZag>::ValueType
+VarIntValue<T, TTraits, TZigZag>::fromSerialisedInternal(
+    SerialisedType value,
+    std::true_type)
+{
+    return static_cast<ValueType>(
+        static_cast<SerialisedType>(
+            (value >> 1) ^
+            (((value & 0x1) != 0) ? std::numeric_limits<SerialisedType>::max() : 0)));
+}
+
+template <typename T, typename TTraits, bool TZigZag>
+constexpr
+const typename VarIntValue<T, TTraits, TZigZag>::ValueType
+VarIntValue<T, TTraits, TZigZag>::fromSerialisedInternal(
+    SerialisedType value,
+    std::false_type)
+{
+    return static_cast<ValueType>(value);
+}
+
+template <typename T, typename TTraits, bool TZigZag>
+template <typename TIter>
+ErrorStatus VarIntValue<T, TTraits, TZigZag>::readInternal(
+    TIter& iter,
+    std::size_t size,
+    std::true_type)
+{
+    if (size < sizeof(std::uint64_t)) {
+        return readInternal(iter, size, std::false_type());
+    }
+
+    std::uint64_t value = 0;
+    auto len = varint_details::decodeWord(
+        reinterpret_cast<const std::uint8_t*>(iter),
+        value);
+
+    if (len == 0) {
+        return readInternal(iter, size, std::false_type());
+    }
+
+    if (MaxLength < len) {
+        return ErrorStatus::ProtocolError;
+    }
+
+    auto status = assignDecoded(value);
+    if (status == ErrorStatus::Success) {
+        iter += len;
+    }
+    return status;
+}
+
+template <typename T, typename TTraits, bool TZigZag>
+template <typename TIter>
+ErrorStatus VarIntValue<T, TTraits, TZigZag>::readInternal(
+    TIter& iter,
+    std::size_t size,
+    std::false_type)
+{
+    std::uint64_t value = 0;
+    auto readIter = iter;
+    auto status = varint_details::decode(readIter, size, MaxLength, value);
+    if (status != ErrorStatus::Success) {
+        return status;
+    }
+
+    status = assignDecoded(value);
+    if (status == ErrorStatus::Success) {
+        iter = readIter;
+    }
+    return status;
+}
+
+template <typename T, typename TTraits, bool TZigZag>
+ErrorStatus VarIntValue<T, TTraits, TZigZag>::assignDecoded(std::uint64_t value)
+{
+    if (static_cast<std::uint64_t>(std::numeric_limits<SerialisedType>::max()) < value) {
+        return ErrorStatus::ProtocolError;
+    }
+
+    setSerialisedValue(static_cast<SerialisedType>(value));
+    return ErrorStatus::Success;
+}
+
+}  // namespace field
+
+}  // namespace comms
+
+}  // namespace embxx
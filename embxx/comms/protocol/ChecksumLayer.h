@@ -24,6 +24,7 @@
 #include "embxx/util/SizeToType.h"
 #include "embxx/comms/traits.h"
 #include "ProtocolLayer.h"
+#include "checksum/ChecksumWriteIterator.h"
 
 namespace embxx
 {
@@ -125,6 +126,11 @@ public:
     ///          to create a message object. If the creation is successful, only
     ///          then the validity of the message object will be verified. In
     ///          case the verification fails the message object will be destructed.
+    ///          When verifying before processing, the checksum is calculated
+    ///          on a copy of the input iterator, which is not rewound, and
+    ///          the iterator is positioned at the end of the frame
+    ///          (after the checksum field) both on success and on
+    ///          verification failure.
     /// @param[in, out] msgPtr Reference to smart pointer that already holds or
     ///                 will hold allocated message object
     /// @param[in, out] iter Input iterator
@@ -177,6 +183,11 @@ public:
     ///          std::back_insert_iterator was used) embxx::comms::ErrorStatus::UpdateRequired
     ///          will be returned. In this case it is needed to call update()
     ///          member function to finalise the write operation.
+    ///          If the WriteIterator is
+    ///          embxx::comms::protocol::checksum::ChecksumWriteIterator, the
+    ///          checksum is accumulated while the next layer writes its data
+    ///          and appended right away, unless the next layer itself
+    ///          requires update.
     /// @param[in] msg Reference to message object
     /// @param[in, out] iter Output iterator.
     /// @param[in] size size of the buffer
@@ -210,6 +221,13 @@ public:
     /// @details Adds "ChecksumLen" to the result of nextLayer().length(msg).
     std::size_t length(const MsgBase& msg) const;
 
+    /// @brief Compile time message serialisation length including protocol
+    ///        stack overhead.
+    /// @details Adds "ChecksumLen" to the result of
+    ///          NextLayer::fixedLength<TMsg>().
+    template <typename TMsg>
+    static constexpr std::size_t fixedLength();
+
 private:
 
     template <typename TMsgPtr>
@@ -239,6 +257,14 @@ private:
         WriteIterator& iter,
         std::size_t size,
         const std::output_iterator_tag& tag) const;
+
+    struct ChecksumWriteIteratorTag {};
+
+    ErrorStatus writeInternal(
+        const MsgBase& msg,
+        WriteIterator& iter,
+        std::size_t size,
+        const ChecksumWriteIteratorTag& tag) const;
 };
 
 // Implementation
@@ -295,7 +321,11 @@ ErrorStatus ChecksumLayer<TTraits, TChecksumCalc, TNextLayer>::write(
             WriteIterator& iter,
             std::size_t size) const
 {
-    typedef typename std::iterator_traits<WriteIterator>::iterator_category IterType;
+    typedef typename std::conditional<
+        checksum::IsChecksumWriteIterator<WriteIterator>::Value,
+        ChecksumWriteIteratorTag,
+        typename std::iterator_traits<WriteIterator>::iterator_category
+    >::type IterType;
     return writeInternal(msg, iter, size, IterType());
 }
 
@@ -335,6 +365,15 @@ std::size_t ChecksumLayer<TTraits, TChecksumCalc, TNextLayer>::length(
     return ChecksumLen + Base::nextLayer().length(msg);
 }
 
+template <typename TTraits,
+          typename TChecksumCalc,
+          typename TNextLayer>
+template <typename TMsg>
+constexpr std::size_t ChecksumLayer<TTraits, TChecksumCalc, TNextLayer>::fixedLength()
+{
+    return ChecksumLen + Base::NextLayer::template fixedLength<TMsg>();
+}
+
 
 template <typename TTraits,
           typename TChecksumCalc,
@@ -349,22 +388,23 @@ ErrorStatus ChecksumLayer<TTraits, TChecksumCalc, TNextLayer>::readInternal(
 {
     static_cast<void>(behaviour);
 
-    auto calculatedChecksum = calcChecksum(iter, size - ChecksumLen);
+    auto dataSize = size - ChecksumLen;
+    ReadIterator dataIter(iter);
+    auto calculatedChecksum = calcChecksum(dataIter, dataSize);
     auto expectedChecksum =
-        Base::template readData<ChecksumType, ChecksumLen>(iter);
+        Base::template readData<ChecksumType, ChecksumLen>(dataIter);
+
     if (calculatedChecksum != expectedChecksum) {
+        iter = dataIter;
         return ErrorStatus::ProtocolError;
     }
 
-    auto advanceSize = -(static_cast<int>(size));
-    std::advance(iter, advanceSize);
-
-    auto status = Base::nextLayer().read(msgPtr, iter, size - ChecksumLen, missingSize);
+    auto status = Base::nextLayer().read(msgPtr, iter, dataSize, missingSize);
+    iter = dataIter;
     if (status != ErrorStatus::Success) {
         return ErrorStatus::ProtocolError;
     }
 
-    std::advance(iter, ChecksumLen);
     return status;
 }
 
@@ -469,6 +509,40 @@ ErrorStatus ChecksumLayer<TTraits, TChecksumCalc, TNextLayer>::writeInternal(
     return ErrorStatus::UpdateRequired;
 }
 
+template <typename TTraits,
+          typename TChecksumCalc,
+          typename TNextLayer>
+ErrorStatus ChecksumLayer<TTraits, TChecksumCalc, TNextLayer>::writeInternal(
+    const MsgBase& msg,
+    WriteIterator& iter,
+    std::size_t size,
+    const ChecksumWriteIteratorTag& tag) const
+{
+    static_cast<void>(tag);
+    static_assert(
+        std::is_same<typename WriteIterator::ChecksumCalc, ChecksumCalc>::value,
+        "WriteIterator must use the same checksum calculator as the layer");
+
+    if (size < ChecksumLen) {
+        return ErrorStatus::BufferOverflow;
+    }
+
+    iter.resetChecksum();
+    auto status = Base::nextLayer().write(msg, iter, size - ChecksumLen);
+    if (status == ErrorStatus::UpdateRequired) {
+        Base::template writeData<ChecksumLen>(0U, iter);
+        return status;
+    }
+
+    if (status != ErrorStatus::Success) {
+        return status;
+    }
+
+    auto checksum = iter.checksum();
+    Base::template writeData<ChecksumLen>(checksum, iter);
+    return ErrorStatus::Success;
+}
+
 }  // namespace protocol
 
 }  // namespace comms
@@ -0,0 +1,253 @@
+//
+// Copyright 2014 (C). Alex Robenko. All rights reserved.
+//
+
+// This library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file embxx/comms/protocol/MsgBatchWriter.h
+/// This file contains definition of the writer serialising multiple messages
+/// back to back into single output buffer.
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+#include "embxx/util/Assert.h"
+#include "embxx/comms/ErrorStatus.h"
+
+namespace embxx
+{
+
+namespace comms
+{
+
+namespace protocol
+{
+
+/// @ingroup comms
+/// @brief Serialises multiple messages back to back into single buffer.
+/// @details When many small messages are sent at the same time, writing
+///          every one of them into separate buffer and issuing separate
+///          asynchronous write request to the driver (or embxx::io::WriteQueue)
+///          multiplies per frame overhead and driver interrupts. This class
+///          writes the frames one after another into single contiguous
+///          buffer, which may be sent with single write request:
+///          @code
+///          MsgBatchWriter<MyProtocolStack> writer(stack, &buf[0], sizeof(buf));
+///          for (auto* msg : pendingMsgs) {
+///              if (writer.add(*msg) != embxx::comms::ErrorStatus::Success) {
+///                  break; // The buffer is full, send the rest next time
+///              }
+///          }
+///          writeQueue.asyncWrite(&buf[0], writer.length(), ...);
+///          @endcode
+///          Space required by every frame is computed once with
+///          length(msg) of the protocol stack before the frame is written,
+///          so the frame that doesn't fit is not written at all.
+/// @tparam TProtStack Protocol stack type (outermost protocol layer).
+/// @pre WriteIterator of the protocol stack must be a random access
+///      iterator, which allows update of the written frame when required.
+/// @headerfile embxx/comms/protocol/MsgBatchWriter.h
+template <typename TProtStack>
+class MsgBatchWriter
+{
+public:
+    /// @brief Protocol stack type
+    typedef TProtStack ProtocolStack;
+
+    /// @brief Base class of all the messages
+    typedef typename ProtocolStack::MsgBase MsgBase;
+
+    /// @brief Output iterator type
+    typedef typename ProtocolStack::WriteIterator WriteIterator;
+
+    static_assert(
+        std::is_base_of<
+            std::random_access_iterator_tag,
+            typename std::iterator_traits<WriteIterator>::iterator_category
+        >::value,
+        "WriteIterator must be random access iterator");
+
+    /// @brief Constructor
+    /// @param stack Protocol stack used to serialise messages.
+    /// @param iter Output iterator to the beginning of the buffer.
+    /// @param capacity Size of the buffer.
+    MsgBatchWriter(const ProtocolStack& stack, WriteIterator iter, std::size_t capacity);
+
+    /// @brief Start new batch.
+    /// @param iter Output iterator to the beginning of the buffer.
+    /// @param capacity Size of the buffer.
+    void reset(WriteIterator iter, std::size_t capacity);
+
+    /// @brief Check whether the message frame fits into the remaining space.
+    bool fits(const MsgBase& msg) const;
+
+    /// @brief Serialise message frame right after the previously added one.
+    /// @param msg Message object
+    /// @return ErrorStatus::Success on success, ErrorStatus::BufferOverflow
+    ///         if the frame doesn't fit into remaining space (nothing is
+    ///         written in this case), or any other error reported by the
+    ///         protocol stack.
+    /// @note Thread safety: Unsafe
+    /// @note Exception guarantee: Basic
+    ErrorStatus add(const MsgBase& msg);
+
+    /// @brief Get iterator to the beginning of the buffer.
+    WriteIterator begin() const;
+
+    /// @brief Get total length of the written frames.
+    std::size_t length() const;
+
+    /// @brief Get number of the written frames.
+    std::size_t count() const;
+
+    /// @brief Get remaining space in the buffer.
+    std::size_t remaining() const;
+
+private:
+    const ProtocolStack& stack_;
+    WriteIterator begin_;
+    WriteIterator iter_;
+    std::size_t capacity_;
+    std::size_t length_;
+    std::size_t count_;
+};
+
+/// @brief Compute total serialisation length of multiple messages
+///        including protocol stack overhead of every one of them.
+/// @param stack Protocol stack
+/// @param msgs Message objects
+/// @return Sum of stack.length(msg) for all provided messages.
+/// @related MsgBatchWriter
+template <typename TProtStack, typename... TMsgs>
+std::size_t batchLength(const TProtStack& stack, const TMsgs&... msgs);
+
+// Implementation
+template <typename TProtStack>
+MsgBatchWriter<TProtStack>::MsgBatchWriter(
+    const ProtocolStack& stack,
+    WriteIterator iter,
+    std::size_t capacity)
+    : stack_(stack),
+      begin_(iter),
+      iter_(iter),
+      capacity_(capacity),
+      length_(0),
+      count_(0)
+{
+}
+
+template <typename TProtStack>
+void MsgBatchWriter<TProtStack>::reset(WriteIterator iter, std::size_t capacity)
+{
+    begin_ = iter;
+    iter_ = iter;
+    capacity_ = capacity;
+    length_ = 0;
+    count_ = 0;
+}
+
+template <typename TProtStack>
+bool MsgBatchWriter<TProtStack>::fits(const MsgBase& msg) const
+{
+    return stack_.length(msg) <= remaining();
+}
+
+template <typename TProtStack>
+ErrorStatus MsgBatchWriter<TProtStack>::add(const MsgBase& msg)
+{
+    auto frameLen = stack_.length(msg);
+    if (remaining() < frameLen) {
+        return ErrorStatus::BufferOverflow;
+    }
+
+    auto frameStart = iter_;
+    auto status = stack_.write(msg, iter_, frameLen);
+    if (status == ErrorStatus::UpdateRequired) {
+        auto updateIter = frameStart;
+        status = stack_.update(updateIter, frameLen);
+    }
+
+    if (status != ErrorStatus::Success) {
+        iter_ = frameStart;
+        return status;
+    }
+
+    GASSERT(static_cast<std::size_t>(std::distance(frameStart, iter_)) == frameLen);
+    length_ += frameLen;
+    ++count_;
+    return status;
+}
+
+template <typename TProtStack>
+typename MsgBatchWriter<TProtStack>::WriteIterator
+MsgBatchWriter<TProtStack>::begin() const
+{
+    return begin_;
+}
+
+template <typename TProtStack>
+std::size_t MsgBatchWriter<TProtStack>::length() const
+{
+    return length_;
+}
+
+template <typename TProtStack>
+std::size_t MsgBatchWriter<TProtStack>::count() const
+{
+    return count_;
+}
+
+template <typename TProtStack>
+std::size_t MsgBatchWriter<TProtStack>::remaining() const
+{
+    return capacity_ - length_;
+}
+
+/// @cond DOCUMENT_BATCH_LENGTH_HELPER
+namespace details
+{
+
+template <typename TProtStack>
+std::size_t batchLengthInternal(const TProtStack& stack)
+{
+    static_cast<void>(stack);
+    return 0;
+}
+
+template <typename TProtStack, typename TMsg, typename... TMsgs>
+std::size_t batchLengthInternal(
+    const TProtStack& stack,
+    const TMsg& msg,
+    const TMsgs&... msgs)
+{
+    return stack.length(msg) + batchLengthInternal(stack, msgs...);
+}
+
+}  // namespace details
+/// @endcond
+
+template <typename TProtStack, typename... TMsgs>
+std::size_t batchLength(const TProtStack& stack, const TMsgs&... msgs)
+{
+    return details::batchLengthInternal(stack, msgs...);
+}
+
+}  // namespace protocol
+
+}  // namespace comms
+
+}  // namespace embxx
@@ -136,6 +136,15 @@ public:
     ///        have any size overhead, result of msg.length() will be returned.
     std::size_t length(const MsgBase& msg) const;
 
+    /// @brief Compile time serialisation length of the message.
+    /// @details Returns TMsg::FixedLength, can be used to reserve buffer
+    ///          space statically.
+    /// @tparam TMsg Message type, its serialisation length must be known
+    ///         at compile time (TMsg::HasFixedLength is true), see
+    ///         embxx::comms::MetaMessageBase.
+    template <typename TMsg>
+    static constexpr std::size_t fixedLength();
+
 };
 
 // Implementation
@@ -196,6 +205,15 @@ std::size_t MsgDataLayer<TMsgBase>::length(const MsgBase& msg) const
     return msg.length();
 }
 
+template <typename TMsgBase>
+template <typename TMsg>
+constexpr std::size_t MsgDataLayer<TMsgBase>::fixedLength()
+{
+    static_assert(TMsg::HasFixedLength,
+        "Serialisation length of the message must be known at compile time");
+    return TMsg::FixedLength;
+}
+
 }  // namespace protocol
 
 }  // namespace comms
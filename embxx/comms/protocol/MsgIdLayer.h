@@ -20,14 +20,15 @@
 
 #pragma once
 
-#include <array>
+#include <cstddef>
 #include <tuple>
-#include <algorithm>
+#include <type_traits>
 #include <utility>
 
 #include "embxx/util/Assert.h"
 #include "embxx/util/Tuple.h"
 #include "embxx/comms/traits.h"
+#include "embxx/comms/MsgIdTable.h"
 #include "ProtocolLayer.h"
 
 namespace embxx
@@ -66,6 +67,14 @@ namespace protocol
 /// @pre TAllMessages must be any variation of std::tuple
 /// @pre All message types in TAllMessages must be in ascending order based on
 ///      their MsgId value
+/// @note The lookup of the message type by ID doesn't involve any virtual
+///       calls. If the IDs are dense (the range between the smallest and the
+///       largest ID is not greater than twice the number of messages), the
+///       message creation function is found by direct indexing of the table
+///       generated at compile time. Otherwise the index of the message type
+///       is found by two level perfect hash of the IDs, which is also
+///       generated at compile time. The compilation fails if collision free
+///       hash of the IDs can't be found.
 /// @headerfile embxx/comms/protocol/MsgIdLayer.h
 template <typename TAllMessages,
           typename TAllocator,
@@ -112,6 +121,11 @@ public:
     /// Length of the message ID field. Originally defined in traits
     static const std::size_t MsgIdLen = Traits::MsgIdLen;
 
+    /// @brief Whether the message IDs are dense enough to be looked up by
+    ///        direct indexing, perfect hash of the IDs is used otherwise.
+    static const bool DirectIdLookup =
+        comms::details::MsgIdTable<AllMessages>::Direct;
+
     /// @brief Constructor
     /// @details Defines static factories responsible for generation of
     ///          custom message objects.
@@ -171,6 +185,40 @@ public:
         std::size_t size,
         std::size_t* missingSize = nullptr);
 
+    /// @brief Read message ID and locate the message payload without
+    ///        allocating the message object.
+    /// @details The function reads message ID from the data sequence and
+    ///          checks it belongs to one of the supported messages. On success
+    ///          the iterator points to the payload of the message, which may be
+    ///          inspected with embxx::comms::MessageView of the message type
+    ///          identified by the reported ID. The next layer is not involved,
+    ///          so the function is expected to be used when the next layer is
+    ///          embxx::comms::protocol::MsgDataLayer and the data has
+    ///          already been unwrapped by the outer layers.
+    /// @param[out] id Read message ID.
+    /// @param[in, out] iter Input iterator
+    /// @param[in] size Size of the data in the sequence
+    /// @param[out] payloadSize Size of the message payload, which follows
+    ///             the message ID.
+    /// @param[out] missingSize If not nullptr and return value is
+    ///             embxx::comms::ErrorStatus::NotEnoughData it will contain
+    ///             minimal missing data length required for the successful
+    ///             read attempt.
+    /// @return Error status of the operation.
+    /// @pre Iterator must be valid and can be dereferenced and incremented at
+    ///      least "size" times;
+    /// @post The iterator is advanced past the message ID.
+    /// @post id and payloadSize output values are updated if and only if
+    ///       function returns embxx::comms::ErrorStatus::Success.
+    /// @note Thread safety: Safe on distinct buffers, unsafe otherwise.
+    /// @note Exception guarantee: No throw
+    ErrorStatus readView(
+        MsgIdType& id,
+        ReadIterator& iter,
+        std::size_t size,
+        std::size_t& payloadSize,
+        std::size_t* missingSize = nullptr) const;
+
     /// @brief Serialise message into output data sequence.
     /// @details The function will write ID of the message to the data
     ///          sequence, then call write() member function of the next
@@ -221,6 +269,13 @@ public:
     /// @details Adds "MsgIdLen" to the result of nextLayer().length(msg).
     std::size_t length(const MsgBase& msg) const;
 
+    /// @brief Compile time message serialisation length including protocol
+    ///        stack overhead.
+    /// @details Adds "MsgIdLen" to the result of
+    ///          NextLayer::fixedLength<TMsg>().
+    template <typename TMsg>
+    static constexpr std::size_t fixedLength();
+
     /// @brief Get allocator.
     /// @details Returns reference to the message allocator. It can be used
     ///          to extend initialisation of the latter if its default
@@ -234,106 +289,20 @@ public:
     const Allocator& getAllocator() const;
 
 private:
-
-    /// @cond DOCUMENT_MSG_ID_PROTOCOL_LAYER_FACTORY
-    class Factory
-    {
-    public:
-
-        virtual ~Factory();
-
-        MsgIdType getId() const;
-
-        MsgPtr create(Allocator& allocator) const;
-
-    protected:
-        virtual MsgIdType getIdImpl() const = 0;
-        virtual MsgPtr createImpl(Allocator& allocator) const = 0;
-    };
+    typedef comms::details::MsgIdTable<AllMessages> IdTable;
+    typedef MsgPtr (*CreateFunc)(Allocator& allocator);
 
     template <typename TMessage>
-    class MsgFactory : public Factory
-    {
-    public:
-        typedef TMessage Message;
-        static const MsgIdType MsgId = Message::MsgId;
-    protected:
-        virtual MsgIdType getIdImpl() const;
-        virtual MsgPtr createImpl(Allocator& allocator) const;
-    private:
-    };
-    /// @endcond
+    static MsgPtr createMsg(Allocator& allocator);
 
-    typedef std::array<Factory*, std::tuple_size<AllMessages>::value> Factories;
+    template <std::size_t... TIndices>
+    static CreateFunc creator(std::size_t idx, util::IndexSequence<TIndices...>);
 
     Allocator allocator_;
-    Factories factories_;
-
 };
 
 // Implementation
 
-namespace details
-{
-
-template <std::size_t TSize>
-struct FactoryCreator
-{
-    template <typename TAllMessages,
-              template <class> class TFactory,
-              typename TFactories>
-    static void create(TFactories& factories)
-    {
-        static const std::size_t Idx = TSize - 1;
-        FactoryCreator<Idx>::template
-                            create<TAllMessages, TFactory>(factories);
-
-        typedef typename std::tuple_element<Idx, TAllMessages>::type Message;
-        static TFactory<Message> factory;
-        factories[Idx] = &factory;
-    }
-};
-
-template <>
-struct FactoryCreator<0>
-{
-    template <typename TAllMessages,
-              template <class> class TFactory,
-              typename TFactories>
-    static void create(TFactories& factories)
-    {
-        static_cast<void>(factories);
-    }
-};
-
-template <std::size_t TEndIdx, typename TAllMessages>
-struct AreMessagesSorted
-{
-    typedef typename std::tuple_element<TEndIdx - 2, TAllMessages>::type FirstElemType;
-    typedef typename std::tuple_element<TEndIdx - 1, TAllMessages>::type SecondElemType;
-
-    static const bool Value =
-        ((FirstElemType::MsgId < SecondElemType::MsgId) &&
-         (AreMessagesSorted<TEndIdx - 1, TAllMessages>::Value));
-};
-
-template <typename TAllMessages>
-struct AreMessagesSorted<1, TAllMessages>
-{
-    static const bool Value = true;
-};
-
-template <typename TAllMessages>
-struct AreMessagesSorted<0, TAllMessages>
-{
-    static const bool Value = true;
-};
-
-
-
-
-}  // namespace details
-
 
 template <typename TAllMessages,
           typename TAllocator,
@@ -344,14 +313,8 @@ MsgIdLayer<TAllMessages, TAllocator, TTraits, TNextLayer>::MsgIdLayer(
     TArgs&&... args)
     : Base(std::forward<TArgs>(args)...)
 {
-    static const std::size_t NumOfMsgs = std::tuple_size<AllMessages>::value;
-
-    static_assert(details::AreMessagesSorted<NumOfMsgs, AllMessages>::Value,
-        "All the message types in the bundle must be sorted in ascending order "
-        "based on their MsgId");
-
-    details::FactoryCreator<NumOfMsgs>::template
-                    create<AllMessages, MsgFactory>(factories_);
+    // Instantiates the ID table, which checks the messages are sorted.
+    static_cast<void>(sizeof(IdTable));
 }
 
 template <typename TAllMessages,
@@ -381,17 +344,14 @@ ErrorStatus MsgIdLayer<TAllMessages, TAllocator, TTraits, TNextLayer>::read(
     }
 
     auto id = Base::template readData<MsgIdType, MsgIdLen>(iter);
-    auto factoryIter = std::lower_bound(factories_.begin(), factories_.end(), id,
-        [](Factory* factory, MsgIdType idVal) -> bool
-        {
-            return factory->getId() < idVal;
-        });
-
-    if ((factoryIter == factories_.end()) || ((*factoryIter)->getId() != id)) {
+    auto createFunc = creator(
+        IdTable::find(id),
+        typename util::MakeIndexSequence<std::tuple_size<AllMessages>::value>::Type());
+    if (createFunc == nullptr) {
         return ErrorStatus::InvalidMsgId;
     }
 
-    msgPtr = (*factoryIter)->create(allocator_);
+    msgPtr = createFunc(allocator_);
     if (!msgPtr) {
         return ErrorStatus::MsgAllocFaulure;
     }
@@ -404,6 +364,34 @@ ErrorStatus MsgIdLayer<TAllMessages, TAllocator, TTraits, TNextLayer>::read(
     return status;
 }
 
+template <typename TAllMessages,
+          typename TAllocator,
+          typename TTraits,
+          typename TNextLayer>
+ErrorStatus MsgIdLayer<TAllMessages, TAllocator, TTraits, TNextLayer>::readView(
+    MsgIdType& id,
+    ReadIterator& iter,
+    std::size_t size,
+    std::size_t& payloadSize,
+    std::size_t* missingSize) const
+{
+    if (size < MsgIdLen) {
+        if (missingSize != nullptr) {
+            *missingSize = length() - size;
+        }
+        return ErrorStatus::NotEnoughData;
+    }
+
+    auto readId = Base::template readData<MsgIdType, MsgIdLen>(iter);
+    if (std::tuple_size<AllMessages>::value <= IdTable::find(readId)) {
+        return ErrorStatus::InvalidMsgId;
+    }
+
+    id = readId;
+    payloadSize = size - MsgIdLen;
+    return ErrorStatus::Success;
+}
+
 template <typename TAllMessages,
           typename TAllocator,
           typename TTraits,
@@ -458,76 +446,63 @@ template <typename TAllMessages,
           typename TAllocator,
           typename TTraits,
           typename TNextLayer>
-typename MsgIdLayer<TAllMessages, TAllocator, TTraits, TNextLayer>::Allocator&
-MsgIdLayer<TAllMessages, TAllocator, TTraits, TNextLayer>::getAllocator()
+template <typename TMsg>
+constexpr std::size_t MsgIdLayer<TAllMessages, TAllocator, TTraits, TNextLayer>::fixedLength()
 {
-    return allocator_;
+    return MsgIdLen + Base::NextLayer::template fixedLength<TMsg>();
 }
 
 template <typename TAllMessages,
           typename TAllocator,
           typename TTraits,
           typename TNextLayer>
-const typename MsgIdLayer<TAllMessages, TAllocator, TTraits, TNextLayer>::Allocator&
-MsgIdLayer<TAllMessages, TAllocator, TTraits, TNextLayer>::getAllocator() const
+typename MsgIdLayer<TAllMessages, TAllocator, TTraits, TNextLayer>::Allocator&
+MsgIdLayer<TAllMessages, TAllocator, TTraits, TNextLayer>::getAllocator()
 {
     return allocator_;
 }
 
-/// @cond DOCUMENT_MSG_ID_PROTOCOL_LAYER_FACTORY
 template <typename TAllMessages,
           typename TAllocator,
           typename TTraits,
           typename TNextLayer>
-MsgIdLayer<TAllMessages, TAllocator, TTraits, TNextLayer>::Factory::~Factory()
-{
-}
-
-
-template <typename TAllMessages,
-          typename TAllocator,
-          typename TTraits,
-          typename TNextLayer>
-typename MsgIdLayer<TAllMessages, TAllocator, TTraits, TNextLayer>::MsgIdType
-MsgIdLayer<TAllMessages, TAllocator, TTraits, TNextLayer>::Factory::getId() const
-{
-    return this->getIdImpl();
-}
-
-template <typename TAllMessages,
-          typename TAllocator,
-          typename TTraits,
-          typename TNextLayer>
-typename MsgIdLayer<TAllMessages, TAllocator, TTraits, TNextLayer>::MsgPtr
-MsgIdLayer<TAllMessages, TAllocator, TTraits, TNextLayer>::Factory::create(
-    Allocator& allocator) const
+const typename MsgIdLayer<TAllMessages, TAllocator, TTraits, TNextLayer>::Allocator&
+MsgIdLayer<TAllMessages, TAllocator, TTraits, TNextLayer>::getAllocator() const
 {
-    return this->createImpl(allocator);
+    return allocator_;
 }
 
+/// @cond DOCUMENT_MSG_ID_PROTOCOL_LAYER_CREATOR
 template <typename TAllMessages,
           typename TAllocator,
           typename TTraits,
           typename TNextLayer>
 template <typename TMessage>
-typename MsgIdLayer<TAllMessages, TAllocator, TTraits, TNextLayer>::MsgIdType
-MsgIdLayer<TAllMessages, TAllocator, TTraits, TNextLayer>::MsgFactory<TMessage>::getIdImpl() const
+typename MsgIdLayer<TAllMessages, TAllocator, TTraits, TNextLayer>::MsgPtr
+MsgIdLayer<TAllMessages, TAllocator, TTraits, TNextLayer>::createMsg(
+    Allocator& allocator)
 {
-    return MsgId;
+    return allocator.template alloc<TMessage>();
 }
 
 template <typename TAllMessages,
           typename TAllocator,
           typename TTraits,
           typename TNextLayer>
-template <typename TMessage>
-typename MsgIdLayer<TAllMessages, TAllocator, TTraits, TNextLayer>::MsgPtr
-MsgIdLayer<TAllMessages, TAllocator, TTraits, TNextLayer>::MsgFactory<TMessage>::createImpl(
-    Allocator& allocator) const
+template <std::size_t... TIndices>
+typename MsgIdLayer<TAllMessages, TAllocator, TTraits, TNextLayer>::CreateFunc
+MsgIdLayer<TAllMessages, TAllocator, TTraits, TNextLayer>::creator(
+    std::size_t idx,
+    util::IndexSequence<TIndices...>)
 {
-    return std::move(allocator.template alloc<Message>());
+    // Last entry corresponds to unknown ID
+    static const CreateFunc Creators[] = {
+        &MsgIdLayer::template createMsg<
+            typename std::tuple_element<TIndices, AllMessages>::type>...,
+        nullptr
+    };
+    return Creators[idx];
 }
-
 /// @endcond
 
 }  // namespace protocol
@@ -205,6 +205,13 @@ public:
     /// @details Adds "MsgSizeLen" to the result of nextLayer().length(msg).
     std::size_t length(const MsgBase& msg) const;
 
+    /// @brief Compile time message serialisation length including protocol
+    ///        stack overhead.
+    /// @details Adds "MsgSizeLen" to the result of
+    ///          NextLayer::fixedLength<TMsg>().
+    template <typename TMsg>
+    static constexpr std::size_t fixedLength();
+
 private:
 
     ErrorStatus write(
@@ -324,6 +331,13 @@ std::size_t MsgSizeLayer<TTraits, TNextLayer>::length(const MsgBase& msg) const
     return MsgSizeLen + Base::nextLayer().length(msg);
 }
 
+template <typename TTraits, typename TNextLayer>
+template <typename TMsg>
+constexpr std::size_t MsgSizeLayer<TTraits, TNextLayer>::fixedLength()
+{
+    return MsgSizeLen + Base::NextLayer::template fixedLength<TMsg>();
+}
+
 template <typename TTraits, typename TNextLayer>
 ErrorStatus MsgSizeLayer<TTraits, TNextLayer>::write(
     const MsgBase& msg,
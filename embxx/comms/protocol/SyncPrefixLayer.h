@@ -22,10 +22,15 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <iterator>
 #include <type_traits>
 #include "embxx/util/Assert.h"
 #include "embxx/util/SizeToType.h"
+#include "embxx/io/access.h"
 #include "embxx/comms/traits.h"
 #include "ProtocolLayer.h"
 
@@ -38,6 +43,79 @@ namespace comms
 namespace protocol
 {
 
+namespace sync_prefix_details
+{
+
+/// @cond DOCUMENT_SYNC_PREFIX_DETAILS
+// Check whether the pattern (or its beginning, when the data is too short)
+// starts at provided position.
+template <typename TIter>
+bool matchPattern(
+    TIter iter,
+    std::size_t size,
+    const std::uint8_t* pattern,
+    std::size_t patternLen)
+{
+    auto count = std::min(size, patternLen);
+    for (auto idx = 0U; idx < count; ++idx) {
+        if (static_cast<std::uint8_t>(*iter) != pattern[idx]) {
+            return false;
+        }
+        ++iter;
+    }
+    return true;
+}
+
+template <typename TIter>
+std::size_t findPattern(
+    TIter iter,
+    std::size_t size,
+    const std::uint8_t* pattern,
+    std::size_t patternLen,
+    std::false_type)
+{
+    for (auto offset = 0U; offset < size; ++offset) {
+        if (matchPattern(iter, size - offset, pattern, patternLen)) {
+            return offset;
+        }
+        ++iter;
+    }
+    return size;
+}
+
+// Contiguous buffer: look for the first byte of the pattern with memchr(),
+// which is vectorised by the standard library, and compare the rest only
+// for the candidates.
+template <typename TIter>
+std::size_t findPattern(
+    TIter iter,
+    std::size_t size,
+    const std::uint8_t* pattern,
+    std::size_t patternLen,
+    std::true_type)
+{
+    auto* bytes = reinterpret_cast<const std::uint8_t*>(iter);
+    auto* pos = bytes;
+    auto* bytesEnd = bytes + size;
+    while (pos != bytesEnd) {
+        auto* found = static_cast<const std::uint8_t*>(
+            std::memchr(pos, pattern[0], static_cast<std::size_t>(bytesEnd - pos)));
+        if (found == nullptr) {
+            break;
+        }
+
+        auto remSize = static_cast<std::size_t>(bytesEnd - found);
+        if (matchPattern(found, remSize, pattern, patternLen)) {
+            return static_cast<std::size_t>(found - bytes);
+        }
+        pos = found + 1;
+    }
+    return size;
+}
+/// @endcond
+
+}  // namespace sync_prefix_details
+
 /// @ingroup comms
 /// @brief Protocol layer that writes/expects "Sync" value prefix before
 ///        forwarding write/read requests to the next layers.
@@ -154,6 +232,83 @@ public:
         std::size_t size,
         SyncPrefixType& sync);
 
+    /// @brief Find the position of the next "sync prefix" in the input data.
+    /// @details Scans the input data sequence for the serialised "sync prefix"
+    ///          value. When the data resides in contiguous buffer (ReadIterator
+    ///          is a pointer to bytes), the candidates are located using
+    ///          std::memchr(). If the end of the data contains only beginning
+    ///          of the "sync prefix", its position is reported, so the bytes
+    ///          are not discarded before the rest arrives.
+    /// @param[in] iter Input iterator, not advanced.
+    /// @param[in] size Size of the data in the sequence
+    /// @return Number of bytes preceding the "sync prefix", equals to "size"
+    ///         if there is none.
+    /// @note Thread safety: Safe
+    /// @note Exception guarantee: No throw
+    std::size_t findSync(ReadIterator iter, std::size_t size) const;
+
+    /// @brief Skip bytes preceding the next "sync prefix" in the input data.
+    /// @details Uses findSync() to locate the "sync prefix" and advances the
+    ///          iterator to its position. The skipped bytes are added to
+    ///          the discardedBytes() counter, and non-zero skip is counted as
+    ///          a resynchronisation event (see resyncCount()).
+    /// @param[in, out] iter Input iterator.
+    /// @param[in] size Size of the data in the sequence
+    /// @return Number of skipped bytes.
+    /// @note Thread safety: Unsafe
+    /// @note Exception guarantee: No throw
+    std::size_t skipToSync(ReadIterator& iter, std::size_t size);
+
+    /// @brief Deserialise message, skipping garbage in the input data.
+    /// @details Unlike read(), it doesn't report embxx::comms::ErrorStatus::ProtocolError
+    ///          on wrong "sync prefix" or when any of the next layers fails to
+    ///          read the message. Instead, the invalid bytes are discarded in
+    ///          bulk up to the next "sync prefix" candidate (see skipToSync())
+    ///          and the read is reattempted from there. Every discarded run of
+    ///          bytes, including the first byte of the false "sync prefix"
+    ///          candidate, is counted as single resynchronisation event
+    ///          (see resyncCount()). It prevents the caller
+    ///          from dropping one byte and retrying the whole protocol stack
+    ///          on every position of the corrupted input.
+    /// @param[in, out] msgPtr Reference to smart pointer that will hold
+    ///                 allocated message object
+    /// @param[in, out] iter Input iterator.
+    /// @param[in] size Size of the data in the sequence
+    /// @param[out] missingSize If not nullptr and return value is
+    ///             embxx::comms::ErrorStatus::NotEnoughData it will contain
+    ///             minimal missing data length required for the successful
+    ///             read attempt.
+    /// @return Error status of the operation: embxx::comms::ErrorStatus::Success,
+    ///         embxx::comms::ErrorStatus::NotEnoughData, or any error other
+    ///         than embxx::comms::ErrorStatus::ProtocolError reported by the
+    ///         next layers (such as embxx::comms::ErrorStatus::InvalidMsgId).
+    /// @pre Iterator must be valid and can be dereferenced and incremented at
+    ///      least "size" times;
+    /// @post On success the iterator is advanced past the read message,
+    ///       otherwise it points to the beginning of the last "sync prefix"
+    ///       candidate (or end of the data), i.e. the distance between
+    ///       original position and the advanced one is number of bytes that
+    ///       can be consumed.
+    /// @note Thread safety: Unsafe
+    /// @note Exception guarantee: Basic
+    template <typename TMsgPtr>
+    ErrorStatus readResync(
+        TMsgPtr& msgPtr,
+        ReadIterator& iter,
+        std::size_t size,
+        std::size_t* missingSize = nullptr);
+
+    /// @brief Get total number of bytes discarded while looking for the
+    ///        "sync prefix".
+    std::size_t discardedBytes() const;
+
+    /// @brief Get number of resynchronisation events, i.e. number of times
+    ///        the garbage preceding the "sync prefix" was discarded.
+    std::size_t resyncCount() const;
+
+    /// @brief Reset discardedBytes() and resyncCount() counters.
+    void resetResyncStats();
+
     /// @brief Serialise message into the output data sequence.
     /// @details The function will write "sync prefix" to the data sequence and
     ///          then it will forward write() request to the next layer.
@@ -190,9 +345,21 @@ public:
     /// @details Adds "SyncPrefixLen" to the result of nextLayer().length(msg).
     std::size_t length(const MsgBase& msg) const;
 
+    /// @brief Compile time message serialisation length including protocol
+    ///        stack overhead.
+    /// @details Adds "SyncPrefixLen" to the result of
+    ///          NextLayer::fixedLength<TMsg>().
+    template <typename TMsg>
+    static constexpr std::size_t fixedLength();
+
 private:
-    const SyncPrefixType sync_;
+    typedef std::integral_constant<
+        bool,
+        io::IsByteBuffer<ReadIterator>::Value> ReadIterTag;
 
+    const SyncPrefixType sync_;
+    std::size_t discardedBytes_;
+    std::size_t resyncCount_;
 };
 
 // Implementation
@@ -202,7 +369,9 @@ SyncPrefixLayer<TTraits, TNextLayer>::SyncPrefixLayer(
     SyncPrefixType sync,
     TArgs&&... args)
     : Base(std::forward<TArgs>(args)...),
-      sync_(sync)
+      sync_(sync),
+      discardedBytes_(0),
+      resyncCount_(0)
 {
 }
 
@@ -258,6 +427,86 @@ ErrorStatus SyncPrefixLayer<TTraits, TNextLayer>::readSync(
     return ErrorStatus::Success;
 }
 
+template <typename TTraits, typename TNextLayer>
+std::size_t SyncPrefixLayer<TTraits, TNextLayer>::findSync(
+    ReadIterator iter,
+    std::size_t size) const
+{
+    std::uint8_t pattern[SyncPrefixLen] = {0};
+    auto* patternIter = &pattern[0];
+    Base::template writeData<SyncPrefixLen>(sync_, patternIter);
+    return sync_prefix_details::findPattern(
+        iter, size, &pattern[0], SyncPrefixLen, ReadIterTag());
+}
+
+template <typename TTraits, typename TNextLayer>
+std::size_t SyncPrefixLayer<TTraits, TNextLayer>::skipToSync(
+    ReadIterator& iter,
+    std::size_t size)
+{
+    auto skipped = findSync(iter, size);
+    if (skipped != 0) {
+        std::advance(iter, skipped);
+        discardedBytes_ += skipped;
+        ++resyncCount_;
+    }
+    return skipped;
+}
+
+template <typename TTraits, typename TNextLayer>
+template <typename TMsgPtr>
+ErrorStatus SyncPrefixLayer<TTraits, TNextLayer>::readResync(
+    TMsgPtr& msgPtr,
+    ReadIterator& iter,
+    std::size_t size,
+    std::size_t* missingSize)
+{
+    while (true) {
+        size -= skipToSync(iter, size);
+
+        auto readIter = iter;
+        auto status = read(msgPtr, readIter, size, missingSize);
+        if (status == ErrorStatus::Success) {
+            iter = readIter;
+            return status;
+        }
+
+        if (status != ErrorStatus::ProtocolError) {
+            return status;
+        }
+
+        // False sync, drop its first byte together with the bytes preceding
+        // the next candidate as single resynchronisation event.
+        GASSERT(0 < size);
+        ++iter;
+        --size;
+        auto skipped = findSync(iter, size);
+        std::advance(iter, skipped);
+        size -= skipped;
+        discardedBytes_ += skipped + 1;
+        ++resyncCount_;
+    }
+}
+
+template <typename TTraits, typename TNextLayer>
+std::size_t SyncPrefixLayer<TTraits, TNextLayer>::discardedBytes() const
+{
+    return discardedBytes_;
+}
+
+template <typename TTraits, typename TNextLayer>
+std::size_t SyncPrefixLayer<TTraits, TNextLayer>::resyncCount() const
+{
+    return resyncCount_;
+}
+
+template <typename TTraits, typename TNextLayer>
+void SyncPrefixLayer<TTraits, TNextLayer>::resetResyncStats()
+{
+    discardedBytes_ = 0;
+    resyncCount_ = 0;
+}
+
 template <typename TTraits, typename TNextLayer>
 ErrorStatus SyncPrefixLayer<TTraits, TNextLayer>::write(
     const MsgBase& msg,
@@ -300,6 +549,13 @@ std::size_t SyncPrefixLayer<TTraits, TNextLayer>::length(
     return SyncPrefixLen + Base::nextLayer().length(msg);
 }
 
+template <typename TTraits, typename TNextLayer>
+template <typename TMsg>
+constexpr std::size_t SyncPrefixLayer<TTraits, TNextLayer>::fixedLength()
+{
+    return SyncPrefixLen + Base::NextLayer::template fixedLength<TMsg>();
+}
+
 
 }  // namespace protocol
 
@@ -18,6 +18,25 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif // #ifdef __SSE2__
+
+#if defined(__GNUC__) && defined(__x86_64__) && \
+    !defined(EMBXX_BYTES_SUM_NO_AVX2)
+#define EMBXX_BYTES_SUM_X86_AVX2
+#include <immintrin.h>
+#endif
+
+#include "embxx/util/SizeToType.h"
+#include "embxx/io/access.h"
+
 namespace embxx
 {
 
@@ -30,10 +49,135 @@ namespace protocol
 namespace checksum
 {
 
+/// @cond DOCUMENT_BYTES_SUM_DETAILS
+namespace bytes_sum_details
+{
+
+// Sums of the bytes of contiguous buffer treated as unsigned values, the
+// tail that doesn't fill the whole block is left to the caller.
+
+// Every 64 bit word is split into four 16 bit lanes, each lane receives
+// two bytes per word, so the lanes must be flushed every 128 words
+// to avoid overflow.
+inline std::uint64_t sumBlocksPortable(const std::uint8_t*& bytes, std::size_t size)
+{
+    static const std::uint64_t LaneMask = 0x00ff00ff00ff00ffULL;
+    static const std::size_t MaxWordsPerFlush = 128U;
+
+    std::uint64_t sum = 0U;
+    auto* bytesEnd = bytes + size;
+    while (sizeof(std::uint64_t) <= static_cast<std::size_t>(bytesEnd - bytes)) {
+        std::uint64_t lanes = 0U;
+        auto words = std::min(
+            MaxWordsPerFlush,
+            static_cast<std::size_t>(bytesEnd - bytes) / sizeof(std::uint64_t));
+        for (auto idx = 0U; idx < words; ++idx) {
+            std::uint64_t word;
+            std::memcpy(&word, bytes, sizeof(word));
+            lanes += (word & LaneMask) + ((word >> 8) & LaneMask);
+            bytes += sizeof(word);
+        }
+        sum +=
+            (lanes & 0xffff) +
+            ((lanes >> 16) & 0xffff) +
+            ((lanes >> 32) & 0xffff) +
+            (lanes >> 48);
+    }
+    return sum;
+}
+
+#ifdef __SSE2__
+inline std::uint64_t sumBlocksSse2(const std::uint8_t*& bytes, std::size_t size)
+{
+    auto* bytesEnd = bytes + size;
+    auto zero = _mm_setzero_si128();
+    auto acc = zero;
+    while (16U <= static_cast<std::size_t>(bytesEnd - bytes)) {
+        auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes));
+        acc = _mm_add_epi64(acc, _mm_sad_epu8(block, zero));
+        bytes += 16;
+    }
+    std::uint64_t partial[2];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&partial[0]), acc);
+    return partial[0] + partial[1];
+}
+#endif // #ifdef __SSE2__
+
+#ifdef EMBXX_BYTES_SUM_X86_AVX2
+// Two independent accumulators of 32 bytes blocks.
+__attribute__((target("avx2")))
+inline std::uint64_t sumBlocksAvx2(const std::uint8_t*& bytes, std::size_t size)
+{
+    auto* bytesEnd = bytes + size;
+    auto zero = _mm256_setzero_si256();
+    auto acc0 = zero;
+    auto acc1 = zero;
+    while (64U <= static_cast<std::size_t>(bytesEnd - bytes)) {
+        auto block0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes));
+        auto block1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes + 32));
+        acc0 = _mm256_add_epi64(acc0, _mm256_sad_epu8(block0, zero));
+        acc1 = _mm256_add_epi64(acc1, _mm256_sad_epu8(block1, zero));
+        bytes += 64;
+    }
+    std::uint64_t partial[4];
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(&partial[0]),
+        _mm256_add_epi64(acc0, acc1));
+    return partial[0] + partial[1] + partial[2] + partial[3];
+}
+
+inline bool avx2Supported()
+{
+#ifdef __AVX2__
+    return true;
+#else // #ifdef __AVX2__
+    static const bool Supported = (__builtin_cpu_supports("avx2") != 0);
+    return Supported;
+#endif // #ifdef __AVX2__
+}
+
+// Shorter buffers are summed by SSE2 instructions
+const std::size_t MinAvx2Size = 256U;
+#endif // #ifdef EMBXX_BYTES_SUM_X86_AVX2
+
+// Sum of all the bytes in contiguous buffer treated as unsigned values.
+inline std::uint64_t sumBuffer(const std::uint8_t* bytes, std::size_t size)
+{
+    auto* bytesEnd = bytes + size;
+
+#if defined(EMBXX_BYTES_SUM_X86_AVX2)
+    std::uint64_t sum = 0U;
+    if ((MinAvx2Size <= size) && avx2Supported()) {
+        sum = sumBlocksAvx2(bytes, size);
+    }
+    sum += sumBlocksSse2(bytes, static_cast<std::size_t>(bytesEnd - bytes));
+#elif defined(__SSE2__)
+    auto sum = sumBlocksSse2(bytes, size);
+#else
+    auto sum = sumBlocksPortable(bytes, size);
+#endif
+
+    while (bytes != bytesEnd) {
+        sum += *bytes;
+        ++bytes;
+    }
+    return sum;
+}
+
+}  // namespace bytes_sum_details
+/// @endcond
+
 /// @ingroup comms
 /// @brief Basic all bytes summary checksum calculator.
 /// @details This class summarises all the bytes in the data sequence and
-///          returns the result as a checksum value.
+///          returns the result as a checksum value. When the data resides
+///          in contiguous buffer (the iterator is a pointer to bytes), the
+///          bytes are summed in blocks, producing exactly the same result.
+///          On x86-64 the blocks are summed with SSE2 instructions, buffers
+///          of at least 256 bytes are summed with AVX2 instructions if the
+///          CPU supports them (checked once at run time). Define
+///          EMBXX_BYTES_SUM_NO_AVX2 symbol to disable the usage of AVX2.
+///          Other targets use portable 64 bit arithmetic.
 /// @tparam TTraits A traits class that must define
 ///         @li ChecksumLen static integral constant specifying length of
 ///             checksum field in bytes.
@@ -71,6 +215,40 @@ public:
     /// @note Exception guarantee: Basic
     template <typename TIter>
     static ChecksumType calc(TIter& iter, std::size_t size)
+    {
+        typedef std::integral_constant<
+            bool,
+            io::IsByteBuffer<TIter>::Value> Tag;
+        return calcInternal(iter, size, Tag());
+    }
+
+    /// @brief Incremental calculation, one byte at a time.
+    /// @details Used by embxx::comms::protocol::checksum::ChecksumWriteIterator.
+    class Accumulator
+    {
+    public:
+        /// @brief Constructor
+        Accumulator() : sum_(ChecksumBase) {}
+
+        /// @brief Add byte to the calculation.
+        void update(std::uint8_t byte)
+        {
+            sum_ = static_cast<ChecksumType>(sum_ + byte);
+        }
+
+        /// @brief Get checksum of all the bytes added so far.
+        ChecksumType value() const
+        {
+            return sum_;
+        }
+
+    private:
+        ChecksumType sum_;
+    };
+
+private:
+    template <typename TIter>
+    static ChecksumType calcInternal(TIter& iter, std::size_t size, std::false_type)
     {
         ChecksumType checksum = ChecksumBase;
         for (auto idx = 0U; idx < size; ++idx) {
@@ -85,6 +263,15 @@ public:
 
         return checksum;
     }
+
+    template <typename TIter>
+    static ChecksumType calcInternal(TIter& iter, std::size_t size, std::true_type)
+    {
+        auto sum = bytes_sum_details::sumBuffer(
+            reinterpret_cast<const std::uint8_t*>(iter), size);
+        iter += size;
+        return static_cast<ChecksumType>(ChecksumBase + static_cast<ChecksumType>(sum));
+    }
 };
 
 }  // namespace checksum
@@ -0,0 +1,183 @@
+//
+// Copyright 2014 (C). Alex Robenko. All rights reserved.
+//
+
+// This library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file embxx/comms/protocol/checksum/ChecksumWriteIterator.h
+/// Output iterator adapter calculating checksum of the written data.
+
+#pragma once
+
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+
+#include "embxx/io/access.h"
+
+namespace embxx
+{
+
+namespace comms
+{
+
+namespace protocol
+{
+
+namespace checksum
+{
+
+/// @ingroup comms
+/// @brief Output iterator adapter that calculates checksum while writing.
+/// @details Every byte assigned through this iterator is forwarded to the
+///          wrapped iterator and accumulated into the checksum at the same
+///          time. When it is used as WriteIterator of the message and the
+///          protocol stack contains embxx::comms::protocol::ChecksumLayer with
+///          the same checksum calculator, the layer appends the accumulated
+///          checksum right after the next layer finishes writing, without
+///          second pass over the written data and without need to call
+///          update().
+///
+///          The checksum is accumulated one byte at a time and the message
+///          fields can't use their bulk copy of contiguous buffers, so the
+///          adapter is beneficial only when the output is not random access
+///          (for example std::back_insert_iterator) and the checksum is cheap
+///          per byte (embxx::comms::protocol::checksum::BytesSum) or the
+///          messages are short (up to few dozens of bytes with CRC).
+///          Writing large messages with CRC is faster with write() followed
+///          by update(), the second pass uses the multi-byte lookup tables.
+///          When the output is a plain pointer to the buffer, use it as is,
+///          ChecksumLayer calculates the checksum of the written contiguous
+///          data in a single call.
+/// @tparam TIter Wrapped output iterator (pointer, std::back_insert_iterator,
+///         etc...)
+/// @tparam TChecksumCalc Checksum calculator, must define Accumulator type
+///         with the following member functions:
+///         @li @code void update(std::uint8_t byte); @endcode
+///         @li @code ChecksumType value() const; @endcode
+/// @headerfile embxx/comms/protocol/checksum/ChecksumWriteIterator.h
+template <typename TIter, typename TChecksumCalc>
+class ChecksumWriteIterator
+{
+public:
+    /// @brief Iterator category
+    typedef std::output_iterator_tag iterator_category;
+
+    /// @brief Type of the written bytes
+    typedef typename io::details::ByteTypeRetriever<
+        TIter,
+        std::is_pointer<TIter>::value>::Type value_type;
+
+    /// @brief Not used
+    typedef void difference_type;
+
+    /// @brief Not used
+    typedef void pointer;
+
+    /// @brief Not used
+    typedef void reference;
+
+    /// @brief Type of the wrapped iterator
+    typedef TIter Iterator;
+
+    /// @brief Checksum calculator
+    typedef TChecksumCalc ChecksumCalc;
+
+    /// @brief Type of the checksum value
+    typedef typename ChecksumCalc::ChecksumType ChecksumType;
+
+    /// @brief Constructor
+    /// @param iter Iterator to wrap
+    explicit ChecksumWriteIterator(Iterator iter)
+        : iter_(iter)
+    {
+    }
+
+    /// @brief Write the byte and accumulate it into the checksum.
+    ChecksumWriteIterator& operator=(value_type byte)
+    {
+        *iter_ = byte;
+        ++iter_;
+        acc_.update(static_cast<std::uint8_t>(byte));
+        return *this;
+    }
+
+    /// @brief No-op, returns reference to itself.
+    ChecksumWriteIterator& operator*()
+    {
+        return *this;
+    }
+
+    /// @brief No-op, the wrapped iterator is advanced on every write.
+    ChecksumWriteIterator& operator++()
+    {
+        return *this;
+    }
+
+    /// @brief No-op, the wrapped iterator is advanced on every write.
+    ChecksumWriteIterator operator++(int)
+    {
+        return *this;
+    }
+
+    /// @brief Restart checksum calculation.
+    void resetChecksum()
+    {
+        acc_ = Accumulator();
+    }
+
+    /// @brief Get checksum of the bytes written since construction or last
+    ///        call to resetChecksum().
+    ChecksumType checksum() const
+    {
+        return acc_.value();
+    }
+
+    /// @brief Get current position of the wrapped iterator.
+    const Iterator& base() const
+    {
+        return iter_;
+    }
+
+private:
+    typedef typename ChecksumCalc::Accumulator Accumulator;
+
+    Iterator iter_;
+    Accumulator acc_;
+};
+
+/// @brief Check whether provided type is ChecksumWriteIterator.
+/// @headerfile embxx/comms/protocol/checksum/ChecksumWriteIterator.h
+template <typename T>
+struct IsChecksumWriteIterator
+{
+    /// @brief Check result
+    static const bool Value = false;
+};
+
+/// @cond DOCUMENT_IS_CHECKSUM_WRITE_ITERATOR_SPECIALISATION
+template <typename TIter, typename TChecksumCalc>
+struct IsChecksumWriteIterator<ChecksumWriteIterator<TIter, TChecksumCalc> >
+{
+    static const bool Value = true;
+};
+/// @endcond
+
+}  // namespace checksum
+
+}  // namespace protocol
+
+}  // namespace comms
+
+}  // namespace embxx
@@ -20,10 +20,13 @@
 
 #pragma once
 
-#include "boost/crc.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
 
 #include "embxx/util/SizeToType.h"
 #include "embxx/util/Assert.h"
+#include "embxx/util/Tuple.h"
 #include "embxx/io/access.h"
 
 namespace embxx
@@ -71,13 +74,159 @@ struct CrcPolynomial<std::uint64_t>
     static const std::uint64_t Value = 0x000000000000001B;
 };
 
+// Compile time generation of the lookup tables entries for MSB first
+// (not reflected) CRC calculation. Entry "idx" of the table
+// "idx / 256" is the remainder of the byte "idx % 256" followed by
+// "idx / 256" zero bytes.
+template <typename T, std::size_t TBits, T TPoly>
+struct CrcTableGen
+{
+    static_assert(std::is_unsigned<T>::value, "T must be unsigned");
+    static_assert((8 <= TBits) && (TBits <= (sizeof(T) * 8)) && ((TBits % 8) == 0),
+        "Unsupported width");
+
+    static constexpr T Mask = static_cast<T>(static_cast<T>(~static_cast<T>(0)) >> ((sizeof(T) * 8) - TBits));
+    static constexpr T TopBit = static_cast<T>(static_cast<T>(1) << (TBits - 1));
+    static constexpr T Poly = static_cast<T>(TPoly & Mask);
+
+    static constexpr T bitStep(T rem)
+    {
+        return static_cast<T>(
+            (((rem & TopBit) != 0) ? ((rem << 1) ^ Poly) : (rem << 1)) & Mask);
+    }
+
+    static constexpr T bitSteps(T rem, std::size_t count)
+    {
+        return (count == 0) ? rem : bitSteps(bitStep(rem), count - 1);
+    }
+
+    static constexpr T byteEntry(std::size_t byte)
+    {
+        return bitSteps(static_cast<T>(static_cast<T>(byte) << (TBits - 8)), 8);
+    }
+
+    static constexpr T zeroByteStep(T rem)
+    {
+        return static_cast<T>(
+            static_cast<T>((TBits == 8) ? 0 : ((rem << 8) & Mask)) ^
+            byteEntry(static_cast<std::size_t>(rem >> (TBits - 8))));
+    }
+
+    static constexpr T zeroByteSteps(T rem, std::size_t count)
+    {
+        return (count == 0) ? rem : zeroByteSteps(zeroByteStep(rem), count - 1);
+    }
+
+    static constexpr T entry(std::size_t idx)
+    {
+        return zeroByteSteps(byteEntry(idx % 256), idx / 256);
+    }
+};
+
+template <typename T, std::size_t TBits, T TPoly, std::size_t TSlices,
+          typename TIndices = typename util::MakeIndexSequence<256 * TSlices>::Type>
+struct CrcTable;
+
+template <typename T, std::size_t TBits, T TPoly, std::size_t TSlices, std::size_t... TIndices>
+struct CrcTable<T, TBits, TPoly, TSlices, util::IndexSequence<TIndices...> >
+{
+    static const T Values[sizeof...(TIndices)];
+};
+
+template <typename T, std::size_t TBits, T TPoly, std::size_t TSlices, std::size_t... TIndices>
+const T CrcTable<T, TBits, TPoly, TSlices, util::IndexSequence<TIndices...> >::Values[sizeof...(TIndices)] = {
+    CrcTableGen<T, TBits, TPoly>::entry(TIndices)...
+};
+
+// Table driven CRC engine. Contiguous buffers (pointers to bytes) are
+// processed 8 bytes per step when TSlices is 8, all other iterators are
+// processed byte by byte.
+template <typename T, std::size_t TBits, T TPoly, std::size_t TSlices>
+class CrcEngine
+{
+    static_assert((TSlices == 1) || (TSlices == 8),
+        "Only 1 or 8 lookup tables are supported");
+
+    typedef CrcTableGen<T, TBits, TPoly> Gen;
+    typedef CrcTable<T, TBits, TPoly, TSlices> Table;
+
+public:
+    template <typename TIter>
+    static T process(T rem, TIter& iter, std::size_t size)
+    {
+        typedef std::integral_constant<
+            bool,
+            (TSlices == 8) && io::IsByteBuffer<TIter>::Value> Tag;
+        return processInternal(rem, iter, size, Tag());
+    }
+
+    static T processByte(T rem, std::uint8_t byte)
+    {
+        auto idx = static_cast<std::uint8_t>((rem >> (TBits - 8)) ^ byte);
+        return static_cast<T>(
+            static_cast<T>((TBits == 8) ? 0 : ((rem << 8) & Gen::Mask)) ^
+            Table::Values[idx]);
+    }
+
+private:
+    template <typename TIter>
+    static T processInternal(T rem, TIter& iter, std::size_t size, std::false_type)
+    {
+        for (auto count = 0U; count < size; ++count) {
+            auto byte = embxx::io::readBig<std::uint8_t>(iter);
+            rem = processByte(rem, byte);
+        }
+        return rem;
+    }
+
+    template <typename TIter>
+    static T processInternal(T rem, TIter& iter, std::size_t size, std::true_type)
+    {
+        auto* bytes = reinterpret_cast<const std::uint8_t*>(iter);
+        auto* bytesEnd = bytes + size;
+        while (8U <= static_cast<std::size_t>(bytesEnd - bytes)) {
+            auto block =
+                (static_cast<std::uint64_t>(bytes[0]) << 56) |
+                (static_cast<std::uint64_t>(bytes[1]) << 48) |
+                (static_cast<std::uint64_t>(bytes[2]) << 40) |
+                (static_cast<std::uint64_t>(bytes[3]) << 32) |
+                (static_cast<std::uint64_t>(bytes[4]) << 24) |
+                (static_cast<std::uint64_t>(bytes[5]) << 16) |
+                (static_cast<std::uint64_t>(bytes[6]) << 8) |
+                static_cast<std::uint64_t>(bytes[7]);
+            block ^= static_cast<std::uint64_t>(rem) << (64 - TBits);
+            rem = static_cast<T>(
+                Table::Values[(7 * 256) + static_cast<std::uint8_t>(block >> 56)] ^
+                Table::Values[(6 * 256) + static_cast<std::uint8_t>(block >> 48)] ^
+                Table::Values[(5 * 256) + static_cast<std::uint8_t>(block >> 40)] ^
+                Table::Values[(4 * 256) + static_cast<std::uint8_t>(block >> 32)] ^
+                Table::Values[(3 * 256) + static_cast<std::uint8_t>(block >> 24)] ^
+                Table::Values[(2 * 256) + static_cast<std::uint8_t>(block >> 16)] ^
+                Table::Values[(1 * 256) + static_cast<std::uint8_t>(block >> 8)] ^
+                Table::Values[static_cast<std::uint8_t>(block)]);
+            bytes += 8;
+        }
+
+        while (bytes != bytesEnd) {
+            rem = processByte(rem, *bytes);
+            ++bytes;
+        }
+
+        iter += size;
+        return rem;
+    }
+};
+
 /// @endcond
 
 }
 
 /// @ingroup comms
 /// @brief Basic CRC checksum calculator.
-/// @details This class uses boost::crc module for calculation of CRC.
+/// @details The CRC is calculated using lookup tables generated at compile
+///          time. When the data resides in contiguous buffer (the iterator
+///          is a pointer to bytes) and TSlices is 8, the data is processed
+///          8 bytes per step ("slice-by-8"), otherwise one byte at a time.
 ///          The truncated polynominals are taken from the table on
 ///          the wikipedia website (http://en.wikipedia.org/wiki/Cyclic_redundancy_check)
 ///          and as following:
@@ -86,12 +235,19 @@ struct CrcPolynomial<std::uint64_t>
 ///          @li CRC-32: 0x04C11DB7
 ///          @li CRC-64: 0x000000000000001B
 ///
-///          All other parameters are default ones.
+///          The calculation is MSB first (not reflected) with initial value
+///          and final XOR value of 0.
 /// @tparam TTraits A traits class that must define
 ///         @li ChecksumLen static integral constant specifying length of
 ///             checksum field in bytes.
+/// @tparam TSlices Number of 256 entries lookup tables to use, either
+///         1 (default) or 8. The tables occupy 256 * TSlices entries of
+///         the checksum size in read only memory: 1 KB for CRC-32 and 2 KB
+///         for CRC-64 with single table versus 8 KB and 16 KB with 8 tables.
+///         Use 8 when the speed on contiguous buffers is more important
+///         than the footprint.
 /// @headerfile embxx/comms/protocol/checksum/Crc.h
-template <typename TTraits>
+template <typename TTraits, std::size_t TSlices = 1>
 class CrcBasic
 {
 public:
@@ -120,17 +276,39 @@ public:
     template <typename TIter>
     static ChecksumType calc(TIter& iter, std::size_t size)
     {
-        static const std::size_t Bits = ChecksumLen * 8;
-        boost::crc_optimal<
-            Bits,
-            crc_details::CrcPolynomial<ChecksumType>::Value> crc;
-        for (auto count = 0U; count < size; ++count) {
-            auto byte = embxx::io::readBig<unsigned char>(iter);
-            crc.process_byte(static_cast<unsigned char>(byte));
-        }
-        auto checksum = crc.checksum();
-        return static_cast<ChecksumType>(checksum);
+        return Engine::process(static_cast<ChecksumType>(0), iter, size);
     }
+
+    /// @brief Incremental CRC calculation, one byte at a time.
+    /// @details Used by embxx::comms::protocol::checksum::ChecksumWriteIterator.
+    class Accumulator
+    {
+    public:
+        /// @brief Constructor
+        Accumulator() : rem_(0) {}
+
+        /// @brief Add byte to the calculation.
+        void update(std::uint8_t byte)
+        {
+            rem_ = Engine::processByte(rem_, byte);
+        }
+
+        /// @brief Get checksum of all the bytes added so far.
+        ChecksumType value() const
+        {
+            return rem_;
+        }
+
+    private:
+        ChecksumType rem_;
+    };
+
+private:
+    typedef crc_details::CrcEngine<
+        ChecksumType,
+        ChecksumLen * 8,
+        crc_details::CrcPolynomial<ChecksumType>::Value,
+        TSlices> Engine;
 };
 
 }  // namespace checksum
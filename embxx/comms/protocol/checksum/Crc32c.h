@@ -0,0 +1,321 @@
+//
+// Copyright 2014 (C). Alex Robenko. All rights reserved.
+//
+
+// This library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file embxx/comms/protocol/checksum/Crc32c.h
+/// CRC-32C (Castagnoli) checksum calculator.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "embxx/util/Tuple.h"
+#include "embxx/io/access.h"
+#include "Crc.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && \
+    !defined(EMBXX_CRC32C_NO_HARDWARE)
+#define EMBXX_CRC32C_X86_HARDWARE
+#endif
+
+namespace embxx
+{
+
+namespace comms
+{
+
+namespace protocol
+{
+
+namespace checksum
+{
+
+namespace crc_details
+{
+
+/// @cond DOCUCMENT_CRC_POLYNOMIAL
+// Compile time generation of the lookup tables entries for LSB first
+// (reflected) CRC-32C calculation.
+struct Crc32cTableGen
+{
+    static const std::uint32_t Poly = 0x82F63B78; // reflected 0x1EDC6F41
+
+    static constexpr std::uint32_t bitSteps(std::uint32_t rem, std::size_t count)
+    {
+        return (count == 0) ?
+            rem :
+            bitSteps((((rem & 0x1) != 0) ? ((rem >> 1) ^ Poly) : (rem >> 1)), count - 1);
+    }
+
+    static constexpr std::uint32_t byteEntry(std::size_t byte)
+    {
+        return bitSteps(static_cast<std::uint32_t>(byte), 8);
+    }
+
+    static constexpr std::uint32_t zeroByteSteps(std::uint32_t rem, std::size_t count)
+    {
+        return (count == 0) ?
+            rem :
+            zeroByteSteps((rem >> 8) ^ byteEntry(rem & 0xff), count - 1);
+    }
+
+    static constexpr std::uint32_t entry(std::size_t idx)
+    {
+        return zeroByteSteps(byteEntry(idx % 256), idx / 256);
+    }
+};
+
+template <typename TIndices = typename util::MakeIndexSequence<256 * 8>::Type>
+struct Crc32cTable;
+
+template <std::size_t... TIndices>
+struct Crc32cTable<util::IndexSequence<TIndices...> >
+{
+    static const std::uint32_t Values[sizeof...(TIndices)];
+};
+
+template <std::size_t... TIndices>
+const std::uint32_t Crc32cTable<util::IndexSequence<TIndices...> >::Values[sizeof...(TIndices)] = {
+    Crc32cTableGen::entry(TIndices)...
+};
+
+class Crc32cEngine
+{
+    typedef Crc32cTable<> Table;
+
+public:
+    template <typename TIter>
+    static std::uint32_t process(std::uint32_t rem, TIter& iter, std::size_t size)
+    {
+        typedef std::integral_constant<
+            bool,
+            io::IsByteBuffer<TIter>::Value> Tag;
+        return processInternal(rem, iter, size, Tag());
+    }
+
+    static std::uint32_t processSoftware(
+        std::uint32_t rem,
+        const std::uint8_t* bytes,
+        std::size_t size)
+    {
+        auto* bytesEnd = bytes + size;
+        while (8U <= static_cast<std::size_t>(bytesEnd - bytes)) {
+            auto block =
+                static_cast<std::uint64_t>(bytes[0]) |
+                (static_cast<std::uint64_t>(bytes[1]) << 8) |
+                (static_cast<std::uint64_t>(bytes[2]) << 16) |
+                (static_cast<std::uint64_t>(bytes[3]) << 24) |
+                (static_cast<std::uint64_t>(bytes[4]) << 32) |
+                (static_cast<std::uint64_t>(bytes[5]) << 40) |
+                (static_cast<std::uint64_t>(bytes[6]) << 48) |
+                (static_cast<std::uint64_t>(bytes[7]) << 56);
+            block ^= rem;
+            rem =
+                Table::Values[(7 * 256) + static_cast<std::uint8_t>(block)] ^
+                Table::Values[(6 * 256) + static_cast<std::uint8_t>(block >> 8)] ^
+                Table::Values[(5 * 256) + static_cast<std::uint8_t>(block >> 16)] ^
+                Table::Values[(4 * 256) + static_cast<std::uint8_t>(block >> 24)] ^
+                Table::Values[(3 * 256) + static_cast<std::uint8_t>(block >> 32)] ^
+                Table::Values[(2 * 256) + static_cast<std::uint8_t>(block >> 40)] ^
+                Table::Values[(1 * 256) + static_cast<std::uint8_t>(block >> 48)] ^
+                Table::Values[static_cast<std::uint8_t>(block >> 56)];
+            bytes += 8;
+        }
+
+        while (bytes != bytesEnd) {
+            rem = processByte(rem, *bytes);
+            ++bytes;
+        }
+        return rem;
+    }
+
+#ifdef EMBXX_CRC32C_X86_HARDWARE
+    __attribute__((target("sse4.2")))
+    static std::uint32_t processHardware(
+        std::uint32_t rem,
+        const std::uint8_t* bytes,
+        std::size_t size)
+    {
+        auto* bytesEnd = bytes + size;
+#ifdef __x86_64__
+        std::uint64_t rem64 = rem;
+        while (8U <= static_cast<std::size_t>(bytesEnd - bytes)) {
+            std::uint64_t block;
+            std::memcpy(&block, bytes, sizeof(block));
+            rem64 = __builtin_ia32_crc32di(rem64, block);
+            bytes += 8;
+        }
+        rem = static_cast<std::uint32_t>(rem64);
+#else // #ifdef __x86_64__
+        while (4U <= static_cast<std::size_t>(bytesEnd - bytes)) {
+            std::uint32_t block;
+            std::memcpy(&block, bytes, sizeof(block));
+            rem = __builtin_ia32_crc32si(rem, block);
+            bytes += 4;
+        }
+#endif // #ifdef __x86_64__
+
+        while (bytes != bytesEnd) {
+            rem = __builtin_ia32_crc32qi(rem, *bytes);
+            ++bytes;
+        }
+        return rem;
+    }
+
+    static bool hardwareSupported()
+    {
+#ifdef __SSE4_2__
+        return true;
+#else // #ifdef __SSE4_2__
+        static const bool Supported = (__builtin_cpu_supports("sse4.2") != 0);
+        return Supported;
+#endif // #ifdef __SSE4_2__
+    }
+#endif // #ifdef EMBXX_CRC32C_X86_HARDWARE
+
+    static std::uint32_t processByte(std::uint32_t rem, std::uint8_t byte)
+    {
+        return (rem >> 8) ^ Table::Values[static_cast<std::uint8_t>(rem ^ byte)];
+    }
+
+private:
+    template <typename TIter>
+    static std::uint32_t processInternal(
+        std::uint32_t rem,
+        TIter& iter,
+        std::size_t size,
+        std::false_type)
+    {
+        for (auto count = 0U; count < size; ++count) {
+            auto byte = embxx::io::readBig<std::uint8_t>(iter);
+            rem = processByte(rem, byte);
+        }
+        return rem;
+    }
+
+    template <typename TIter>
+    static std::uint32_t processInternal(
+        std::uint32_t rem,
+        TIter& iter,
+        std::size_t size,
+        std::true_type)
+    {
+        auto* bytes = reinterpret_cast<const std::uint8_t*>(iter);
+        iter += size;
+#ifdef EMBXX_CRC32C_X86_HARDWARE
+        if (hardwareSupported()) {
+            return processHardware(rem, bytes, size);
+        }
+#endif // #ifdef EMBXX_CRC32C_X86_HARDWARE
+        return processSoftware(rem, bytes, size);
+    }
+};
+
+/// @endcond
+
+}  // namespace crc_details
+
+/// @ingroup comms
+/// @brief CRC-32C (Castagnoli) checksum calculator.
+/// @details Calculates CRC-32C as used by iSCSI, SCTP and ext4: polynomial
+///          0x1EDC6F41, reflected input and output, initial value and
+///          final XOR value of 0xFFFFFFFF.
+///
+///          When the data resides in contiguous buffer (the iterator is a
+///          pointer to bytes) and the code is compiled for x86 with GCC or
+///          Clang, the availability of SSE4.2 crc32 instruction is checked
+///          at run time (once) and used if supported. Otherwise the checksum
+///          is calculated using "slice-by-8" lookup tables generated at
+///          compile time. Any other iterators are processed byte by byte.
+///          Define EMBXX_CRC32C_NO_HARDWARE symbol to disable the usage of
+///          the hardware instructions.
+/// @tparam TTraits A traits class that must define
+///         @li ChecksumLen static integral constant specifying length of
+///             checksum field in bytes, must be 4.
+/// @headerfile embxx/comms/protocol/checksum/Crc32c.h
+template <typename TTraits>
+class Crc32c
+{
+public:
+
+    /// @brief Traits
+    typedef TTraits Traits;
+
+    /// @brief Length of the message checksum field. Originally defined in traits.
+    static const std::size_t ChecksumLen = Traits::ChecksumLen;
+
+    static_assert(ChecksumLen == sizeof(std::uint32_t),
+        "CRC-32C requires 4 bytes checksum field");
+
+    /// @brief Type of the checksum value
+    typedef std::uint32_t ChecksumType;
+
+    /// @brief CRC calculation function.
+    /// @tparam TIter Type of input iterator
+    /// @param[in, out] iter Input iterator
+    /// @param[in] size Size of the data in the buffer
+    /// @return Checksum value
+    /// @pre Iterator must be valid and can be dereferenced and incremented at
+    ///      least "size" times;
+    /// @post The iterator will be advanced by the number of bytes was actually
+    ///       read.
+    /// @note Thread safety: Safe
+    /// @note Exception guarantee: Basic
+    template <typename TIter>
+    static ChecksumType calc(TIter& iter, std::size_t size)
+    {
+        auto rem = crc_details::Crc32cEngine::process(InitValue, iter, size);
+        return rem ^ InitValue;
+    }
+
+    /// @brief Incremental CRC calculation, one byte at a time.
+    /// @details Used by embxx::comms::protocol::checksum::ChecksumWriteIterator.
+    class Accumulator
+    {
+    public:
+        /// @brief Constructor
+        Accumulator() : rem_(InitValue) {}
+
+        /// @brief Add byte to the calculation.
+        void update(std::uint8_t byte)
+        {
+            rem_ = crc_details::Crc32cEngine::processByte(rem_, byte);
+        }
+
+        /// @brief Get checksum of all the bytes added so far.
+        ChecksumType value() const
+        {
+            return rem_ ^ InitValue;
+        }
+
+    private:
+        ChecksumType rem_;
+    };
+
+private:
+    static const ChecksumType InitValue = 0xffffffff;
+};
+
+}  // namespace checksum
+
+}  // namespace protocol
+
+}  // namespace comms
+
+}  // namespace embxx
@@ -0,0 +1,333 @@
+//
+// Copyright 2014 (C). Alex Robenko. All rights reserved.
+//
+
+// This library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file embxx/comms/protocol/checksum/CrcFold.h
+/// CRC checksum calculator for arbitrary 32 and 64 bit polynomials using
+/// carry-less multiplication folding.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "embxx/util/Assert.h"
+#include "embxx/util/SizeToType.h"
+#include "embxx/io/access.h"
+#include "Crc.h"
+
+#if defined(__GNUC__) && defined(__x86_64__) && \
+    !defined(EMBXX_CRC_FOLD_NO_HARDWARE)
+#define EMBXX_CRC_FOLD_X86_HARDWARE
+#include <immintrin.h>
+#endif
+
+namespace embxx
+{
+
+namespace comms
+{
+
+namespace protocol
+{
+
+namespace checksum
+{
+
+namespace crc_details
+{
+
+/// @cond DOCUCMENT_CRC_POLYNOMIAL
+// MSB first (not reflected) CRC engine folding 16 bytes blocks with
+// carry-less multiplication. Every block is loaded as 128 bit polynomial,
+// the highest bit of the first byte being the highest coefficient. The
+// accumulated value A is shifted over the next block as
+// A * x^128 = A_hi * x^192 + A_lo * x^128, where x^192 and x^128 are replaced
+// with their remainders modulo the polynomial, computed at compile time.
+// Four accumulators are folded in parallel while at least 64 bytes remain.
+// The final 128 bit accumulator and the remaining tail are reduced by
+// the table driven engine.
+template <typename T, std::size_t TBits, T TPoly>
+class CrcFoldEngine
+{
+    static_assert((TBits == 32) || (TBits == 64),
+        "Only 32 and 64 bit polynomials are supported");
+
+    typedef CrcTableGen<T, TBits, TPoly> Gen;
+    typedef CrcEngine<T, TBits, TPoly, 8> TableEngine;
+
+public:
+    // x^power mod P, power must be TBits + N * 8
+    static constexpr T xPowMod(std::size_t power)
+    {
+        return Gen::zeroByteSteps(Gen::Poly, (power - TBits) / 8);
+    }
+
+    static constexpr T Fold1Lo = xPowMod(128);
+    static constexpr T Fold1Hi = xPowMod(128 + 64);
+    static constexpr T Fold4Lo = xPowMod(512);
+    static constexpr T Fold4Hi = xPowMod(512 + 64);
+
+    // Shorter buffers are processed by the table driven engine
+    static const std::size_t MinFoldSize = 64;
+
+    template <typename TIter>
+    static T process(T rem, TIter& iter, std::size_t size)
+    {
+        typedef std::integral_constant<
+            bool,
+            io::IsByteBuffer<TIter>::Value> Tag;
+        return processInternal(rem, iter, size, Tag());
+    }
+
+    static T processByte(T rem, std::uint8_t byte)
+    {
+        return TableEngine::processByte(rem, byte);
+    }
+
+    static T processSoftware(T rem, const std::uint8_t* bytes, std::size_t size)
+    {
+        return TableEngine::process(rem, bytes, size);
+    }
+
+#ifdef EMBXX_CRC_FOLD_X86_HARDWARE
+    __attribute__((target("pclmul,ssse3")))
+    static T processHardware(T rem, const std::uint8_t* bytes, std::size_t size)
+    {
+        GASSERT(MinFoldSize <= size);
+        auto* bytesEnd = bytes + size;
+        auto swapMask =
+            _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+
+        auto initRem =
+            _mm_set_epi64x(
+                static_cast<long long>(static_cast<std::uint64_t>(rem) << (64 - TBits)),
+                0);
+
+        auto acc0 = _mm_xor_si128(loadBlock(bytes, swapMask), initRem);
+        auto acc1 = loadBlock(bytes + 16, swapMask);
+        auto acc2 = loadBlock(bytes + 32, swapMask);
+        auto acc3 = loadBlock(bytes + 48, swapMask);
+        bytes += 64;
+
+        auto fold4 =
+            _mm_set_epi64x(
+                static_cast<long long>(Fold4Hi),
+                static_cast<long long>(Fold4Lo));
+        while (64U <= static_cast<std::size_t>(bytesEnd - bytes)) {
+            acc0 = foldBlock(acc0, loadBlock(bytes, swapMask), fold4);
+            acc1 = foldBlock(acc1, loadBlock(bytes + 16, swapMask), fold4);
+            acc2 = foldBlock(acc2, loadBlock(bytes + 32, swapMask), fold4);
+            acc3 = foldBlock(acc3, loadBlock(bytes + 48, swapMask), fold4);
+            bytes += 64;
+        }
+
+        auto fold1 =
+            _mm_set_epi64x(
+                static_cast<long long>(Fold1Hi),
+                static_cast<long long>(Fold1Lo));
+        acc0 = foldBlock(acc0, acc1, fold1);
+        acc0 = foldBlock(acc0, acc2, fold1);
+        acc0 = foldBlock(acc0, acc3, fold1);
+        while (16U <= static_cast<std::size_t>(bytesEnd - bytes)) {
+            acc0 = foldBlock(acc0, loadBlock(bytes, swapMask), fold1);
+            bytes += 16;
+        }
+
+        std::uint8_t block[16];
+        _mm_storeu_si128(
+            reinterpret_cast<__m128i*>(&block[0]),
+            _mm_shuffle_epi8(acc0, swapMask));
+
+        const std::uint8_t* blockIter = &block[0];
+        rem = TableEngine::process(static_cast<T>(0), blockIter, sizeof(block));
+        return TableEngine::process(
+            rem,
+            bytes,
+            static_cast<std::size_t>(bytesEnd - bytes));
+    }
+
+    static bool hardwareSupported()
+    {
+#if defined(__PCLMUL__) && defined(__SSSE3__)
+        return true;
+#else // #if defined(__PCLMUL__) && defined(__SSSE3__)
+        static const bool Supported =
+            (__builtin_cpu_supports("pclmul") != 0) &&
+            (__builtin_cpu_supports("ssse3") != 0);
+        return Supported;
+#endif // #if defined(__PCLMUL__) && defined(__SSSE3__)
+    }
+#endif // #ifdef EMBXX_CRC_FOLD_X86_HARDWARE
+
+private:
+#ifdef EMBXX_CRC_FOLD_X86_HARDWARE
+    __attribute__((target("pclmul,ssse3")))
+    static __m128i loadBlock(const std::uint8_t* bytes, __m128i swapMask)
+    {
+        return _mm_shuffle_epi8(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes)),
+            swapMask);
+    }
+
+    __attribute__((target("pclmul,ssse3")))
+    static __m128i foldBlock(__m128i acc, __m128i data, __m128i consts)
+    {
+        return _mm_xor_si128(
+            _mm_xor_si128(
+                _mm_clmulepi64_si128(acc, consts, 0x11),
+                _mm_clmulepi64_si128(acc, consts, 0x00)),
+            data);
+    }
+#endif // #ifdef EMBXX_CRC_FOLD_X86_HARDWARE
+
+    template <typename TIter>
+    static T processInternal(T rem, TIter& iter, std::size_t size, std::false_type)
+    {
+        return TableEngine::process(rem, iter, size);
+    }
+
+    template <typename TIter>
+    static T processInternal(T rem, TIter& iter, std::size_t size, std::true_type)
+    {
+        auto* bytes = reinterpret_cast<const std::uint8_t*>(iter);
+        iter += size;
+#ifdef EMBXX_CRC_FOLD_X86_HARDWARE
+        if ((MinFoldSize <= size) && hardwareSupported()) {
+            return processHardware(rem, bytes, size);
+        }
+#endif // #ifdef EMBXX_CRC_FOLD_X86_HARDWARE
+        return processSoftware(rem, bytes, size);
+    }
+};
+
+template <typename T, std::size_t TBits, T TPoly>
+constexpr T CrcFoldEngine<T, TBits, TPoly>::Fold1Lo;
+
+template <typename T, std::size_t TBits, T TPoly>
+constexpr T CrcFoldEngine<T, TBits, TPoly>::Fold1Hi;
+
+template <typename T, std::size_t TBits, T TPoly>
+constexpr T CrcFoldEngine<T, TBits, TPoly>::Fold4Lo;
+
+template <typename T, std::size_t TBits, T TPoly>
+constexpr T CrcFoldEngine<T, TBits, TPoly>::Fold4Hi;
+
+/// @endcond
+
+}  // namespace crc_details
+
+/// @ingroup comms
+/// @brief CRC checksum calculator for arbitrary 32 and 64 bit polynomials.
+/// @details Calculates the same MSB first (not reflected) CRC with initial
+///          value and final XOR value of 0 as CrcBasic, but allows
+///          specification of any polynomial of 32 or 64 bits.
+///
+///          When the data resides in contiguous buffer (the iterator is a
+///          pointer to bytes) of at least 64 bytes and the code is compiled
+///          for x86-64 with GCC or Clang, the availability of PCLMULQDQ
+///          (carry-less multiplication) instruction is checked at run time
+///          (once) and the data is folded 64 bytes per step. The folding
+///          constants are generated at compile time. Otherwise the checksum
+///          is calculated by the same "slice-by-8" lookup tables as
+///          CrcBasic uses. Any other iterators are processed byte by byte.
+///          Define EMBXX_CRC_FOLD_NO_HARDWARE symbol to disable the usage of
+///          the hardware instructions.
+/// @tparam TTraits A traits class that must define
+///         @li ChecksumLen static integral constant specifying length of
+///             checksum field in bytes, must be 4 or 8.
+/// @tparam TPoly Truncated polynomial (without the highest bit), defaults
+///         to the one used by CrcBasic of the same length.
+/// @headerfile embxx/comms/protocol/checksum/CrcFold.h
+template <typename TTraits,
+          typename util::SizeToType<TTraits::ChecksumLen>::Type TPoly =
+            crc_details::CrcPolynomial<
+                typename util::SizeToType<TTraits::ChecksumLen>::Type>::Value>
+class CrcFold
+{
+public:
+
+    /// @brief Traits
+    typedef TTraits Traits;
+
+    /// @brief Length of the message checksum field. Originally defined in traits.
+    static const std::size_t ChecksumLen = Traits::ChecksumLen;
+
+    static_assert((ChecksumLen == 4) || (ChecksumLen == 8),
+        "Only 4 and 8 bytes checksum fields are supported");
+
+    /// @brief Type of the checksum value
+    typedef typename util::SizeToType<ChecksumLen>::Type ChecksumType;
+
+    /// @brief Truncated polynomial
+    static const ChecksumType Polynomial = TPoly;
+
+    /// @brief CRC calculation function.
+    /// @tparam TIter Type of input iterator
+    /// @param[in, out] iter Input iterator
+    /// @param[in] size Size of the data in the buffer
+    /// @return Checksum value
+    /// @pre Iterator must be valid and can be dereferenced and incremented at
+    ///      least "size" times;
+    /// @post The iterator will be advanced by the number of bytes was actually
+    ///       read.
+    /// @note Thread safety: Safe
+    /// @note Exception guarantee: Basic
+    template <typename TIter>
+    static ChecksumType calc(TIter& iter, std::size_t size)
+    {
+        return Engine::process(static_cast<ChecksumType>(0), iter, size);
+    }
+
+    /// @brief Incremental CRC calculation, one byte at a time.
+    /// @details Used by embxx::comms::protocol::checksum::ChecksumWriteIterator.
+    class Accumulator
+    {
+    public:
+        /// @brief Constructor
+        Accumulator() : rem_(0) {}
+
+        /// @brief Add byte to the calculation.
+        void update(std::uint8_t byte)
+        {
+            rem_ = Engine::processByte(rem_, byte);
+        }
+
+        /// @brief Get checksum of all the bytes added so far.
+        ChecksumType value() const
+        {
+            return rem_;
+        }
+
+    private:
+        ChecksumType rem_;
+    };
+
+private:
+    typedef crc_details::CrcFoldEngine<
+        ChecksumType,
+        ChecksumLen * 8,
+        TPoly> Engine;
+};
+
+}  // namespace checksum
+
+}  // namespace protocol
+
+}  // namespace comms
+
+}  // namespace embxx
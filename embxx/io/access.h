@@ -18,15 +18,31 @@
 /// @file embxx/io/access.h
 /// Simple data access module.
 /// Provides an ability to read/write serialised integral types using iterators.
+/// When compiled with GCC or Clang and the iterator is a pointer to bytes,
+/// values of 2, 4 and 8 bytes are accessed with single unaligned load/store
+/// of the whole word (std::memcpy), followed by the byte swap intrinsic when
+/// the requested endianness differs from the one of the host. Define
+/// EMBXX_IO_NO_BULK_ACCESS symbol to always access the data byte by byte.
 
 #pragma once
 
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
 #include <type_traits>
 
 #include "traits.h"
 
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && \
+    !defined(EMBXX_IO_NO_BULK_ACCESS)
+#if (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) || \
+    (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+#define EMBXX_IO_BULK_ACCESS
+#endif
+#endif
+
 namespace embxx
 {
 
@@ -191,6 +207,72 @@ T readData(TIter& iter, const traits::endian::Little& endian);
 template <typename T, std::size_t TSize, typename TIter>
 T readData(TIter& iter, const traits::endian::Little& endian);
 
+/// @brief Read (de-serialise) sequence of integral values, every one of
+///        them occupying sizeof(T) bytes.
+/// @details When the iterator is a pointer to bytes, the whole sequence is
+///          copied with single std::memcpy and byte swapped in place if the
+///          endianness differs from the one of the host. Otherwise every
+///          value is read separately.
+/// @tparam T Type of the values. Must be integral type.
+/// @tparam TIter Type of the input iterator.
+/// @tparam TEndian Either traits::endian::Big or traits::endian::Little.
+/// @param[out] values Pointer to the storage of the values.
+/// @param[in] count Number of values to read.
+/// @param[in, out] iter Input iterator of character stream.
+/// @param[in] endian Endianness tag.
+/// @pre The stream must contain at least count * sizeof(T) bytes.
+/// @post The iterator is advanced.
+/// @note Exception guarantee: Basic
+template <typename T, typename TIter, typename TEndian>
+void readDataArray(
+    T* values,
+    std::size_t count,
+    TIter& iter,
+    const TEndian& endian);
+
+/// @brief Write (serialise) sequence of integral values, every one of
+///        them occupying sizeof(T) bytes.
+/// @details When the iterator is a pointer to bytes, the whole sequence is
+///          copied with single std::memcpy if the endianness is the same as
+///          the one of the host, or byte swapped directly into the output
+///          buffer otherwise. Other iterators write every value separately.
+/// @tparam T Type of the values. Must be integral type.
+/// @tparam TIter Type of the output iterator.
+/// @tparam TEndian Either traits::endian::Big or traits::endian::Little.
+/// @param[in] values Pointer to the values.
+/// @param[in] count Number of values to write.
+/// @param[in, out] iter Output iterator of character stream.
+/// @param[in] endian Endianness tag.
+/// @pre The stream must have space for at least count * sizeof(T) bytes.
+/// @post The iterator is advanced.
+/// @note Exception guarantee: Basic
+template <typename T, typename TIter, typename TEndian>
+void writeDataArray(
+    const T* values,
+    std::size_t count,
+    TIter& iter,
+    const TEndian& endian);
+
+/// @brief Check whether the iterator is a pointer to contiguous buffer of
+///        bytes.
+/// @details Such iterators allow processing of the data in blocks rather
+///          than byte by byte, the result is reported in Value static
+///          member.
+/// @tparam TIter Type of the iterator.
+template <typename TIter>
+struct IsByteBuffer
+{
+    /// @brief Type of the buffer element
+    typedef typename std::remove_cv<
+        typename std::remove_pointer<TIter>::type>::type ValueType;
+
+    /// @brief true if and only if TIter is a pointer to integral bytes.
+    static const bool Value =
+        std::is_pointer<TIter>::value &&
+        std::is_integral<ValueType>::value &&
+        (sizeof(ValueType) == 1U);
+};
+
 /// @}
 
 // Implementation part
@@ -610,6 +692,101 @@ struct ReadHelper<TEndian, true>
     }
 };
 
+template <std::size_t TSize>
+struct BulkAccessWord;
+
+template <typename TIter, std::size_t TSize>
+struct IsBulkAccessible
+{
+    static const bool Value =
+#ifdef EMBXX_IO_BULK_ACCESS
+        IsByteBuffer<TIter>::Value &&
+        (std::numeric_limits<unsigned char>::digits == 8) &&
+        ((TSize == 2) || (TSize == 4) || (TSize == 8));
+#else // #ifdef EMBXX_IO_BULK_ACCESS
+        false;
+#endif // #ifdef EMBXX_IO_BULK_ACCESS
+};
+
+#ifdef EMBXX_IO_BULK_ACCESS
+
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+typedef traits::endian::Little HostEndian;
+#else // #if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+typedef traits::endian::Big HostEndian;
+#endif // #if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+
+template <>
+struct BulkAccessWord<2>
+{
+    typedef std::uint16_t Type;
+    static Type swap(Type value)
+    {
+        return __builtin_bswap16(value);
+    }
+};
+
+template <>
+struct BulkAccessWord<4>
+{
+    typedef std::uint32_t Type;
+    static Type swap(Type value)
+    {
+        return __builtin_bswap32(value);
+    }
+};
+
+template <>
+struct BulkAccessWord<8>
+{
+    typedef std::uint64_t Type;
+    static Type swap(Type value)
+    {
+        return __builtin_bswap64(value);
+    }
+};
+
+template <typename TEndian, std::size_t TSize>
+struct BulkAccess
+{
+    typedef BulkAccessWord<TSize> Word;
+    typedef typename Word::Type WordType;
+
+    static WordType toHost(WordType value, std::true_type)
+    {
+        return value;
+    }
+
+    static WordType toHost(WordType value, std::false_type)
+    {
+        return Word::swap(value);
+    }
+
+    static WordType toHost(WordType value)
+    {
+        return toHost(value, std::is_same<TEndian, HostEndian>());
+    }
+
+    template <typename TIter>
+    static WordType read(TIter& iter)
+    {
+        WordType value;
+        std::memcpy(&value, iter, sizeof(value));
+        iter += TSize;
+        return toHost(value);
+    }
+
+    template <typename TIter>
+    static void write(WordType value, TIter& iter)
+    {
+        value = toHost(value); // swap is symmetric
+        std::memcpy(iter, &value, sizeof(value));
+        iter += TSize;
+    }
+};
+
+#endif // #ifdef EMBXX_IO_BULK_ACCESS
+
 template <template <typename, bool> class THelper>
 struct Writer
 {
@@ -620,14 +797,33 @@ struct Writer
         typedef details::OptimisedValueType<ValueType> OptimisedValueType;
 
         static_assert(TSize <= sizeof(ValueType), "Precondition failure");
+        typedef std::integral_constant<
+            bool,
+            IsBulkAccessible<TIter, TSize>::Value> BulkTag;
+        writeInternal<TEndian, TSize>(
+            static_cast<OptimisedValueType>(value), iter, BulkTag());
+    }
+
+private:
+    template <typename TEndian, std::size_t TSize, typename T, typename TIter>
+    static void writeInternal(T value, TIter& iter, std::false_type)
+    {
         static const bool IsRandomAccess =
             std::is_same<
                 typename std::iterator_traits<TIter>::iterator_category,
                 std::random_access_iterator_tag
             >::value;
-        THelper<TEndian, IsRandomAccess>::write(
-                            static_cast<OptimisedValueType>(value), TSize, iter);
+        THelper<TEndian, IsRandomAccess>::write(value, TSize, iter);
+    }
+
+#ifdef EMBXX_IO_BULK_ACCESS
+    template <typename TEndian, std::size_t TSize, typename T, typename TIter>
+    static void writeInternal(T value, TIter& iter, std::true_type)
+    {
+        typedef BulkAccess<TEndian, TSize> Access;
+        Access::write(static_cast<typename Access::WordType>(value), iter);
     }
+#endif // #ifdef EMBXX_IO_BULK_ACCESS
 };
 
 template <template <typename, bool> class THelper>
@@ -641,20 +837,136 @@ struct Reader
         typedef details::ByteType<TIter> ByteType;
 
         static_assert(TSize <= sizeof(ValueType), "Precondition failure");
-        static const bool IsRandomAccess =
-            std::is_same<
-                typename std::iterator_traits<TIter>::iterator_category,
-                std::random_access_iterator_tag
-            >::value;
+        typedef std::integral_constant<
+            bool,
+            IsBulkAccessible<TIter, TSize>::Value> BulkTag;
         auto retval =
             static_cast<ValueType>(
-                THelper<TEndian, IsRandomAccess>::template read<OptimisedValueType>(TSize, iter));
+                readInternal<TEndian, OptimisedValueType, TSize>(iter, BulkTag()));
 
         if (std::is_signed<ValueType>::value) {
             retval = details::SignExt<decltype(retval), TSize, ByteType>::value(retval);
         }
         return static_cast<T>(retval);
     }
+
+private:
+    template <typename TEndian, typename T, std::size_t TSize, typename TIter>
+    static T readInternal(TIter& iter, std::false_type)
+    {
+        static const bool IsRandomAccess =
+            std::is_same<
+                typename std::iterator_traits<TIter>::iterator_category,
+                std::random_access_iterator_tag
+            >::value;
+        return THelper<TEndian, IsRandomAccess>::template read<T>(TSize, iter);
+    }
+
+#ifdef EMBXX_IO_BULK_ACCESS
+    template <typename TEndian, typename T, std::size_t TSize, typename TIter>
+    static T readInternal(TIter& iter, std::true_type)
+    {
+        return static_cast<T>(BulkAccess<TEndian, TSize>::read(iter));
+    }
+#endif // #ifdef EMBXX_IO_BULK_ACCESS
+};
+
+template <typename TIter, typename T>
+struct IsBulkArrayAccessible
+{
+    static const bool Value =
+#ifdef EMBXX_IO_BULK_ACCESS
+        IsByteBuffer<TIter>::Value &&
+        (std::numeric_limits<unsigned char>::digits == 8) &&
+        std::is_integral<T>::value &&
+        ((sizeof(T) == 1) || (sizeof(T) == 2) ||
+         (sizeof(T) == 4) || (sizeof(T) == 8));
+#else // #ifdef EMBXX_IO_BULK_ACCESS
+        false;
+#endif // #ifdef EMBXX_IO_BULK_ACCESS
+};
+
+template <typename TEndian>
+struct ArrayAccess
+{
+    template <typename T, typename TIter>
+    static void read(T* values, std::size_t count, TIter& iter, std::false_type)
+    {
+        for (std::size_t idx = 0; idx < count; ++idx) {
+            values[idx] = readData<T>(iter, TEndian());
+        }
+    }
+
+    template <typename T, typename TIter>
+    static void write(const T* values, std::size_t count, TIter& iter, std::false_type)
+    {
+        for (std::size_t idx = 0; idx < count; ++idx) {
+            writeData(values[idx], iter, TEndian());
+        }
+    }
+
+#ifdef EMBXX_IO_BULK_ACCESS
+    template <typename T>
+    using NeedSwap =
+        std::integral_constant<
+            bool,
+            (1U < sizeof(T)) && (!std::is_same<TEndian, HostEndian>::value)
+        >;
+
+    template <typename T, typename TIter>
+    static void read(T* values, std::size_t count, TIter& iter, std::true_type)
+    {
+        std::memcpy(values, iter, count * sizeof(T));
+        iter += count * sizeof(T);
+        swapInPlace(values, count, NeedSwap<T>());
+    }
+
+    template <typename T, typename TIter>
+    static void write(const T* values, std::size_t count, TIter& iter, std::true_type)
+    {
+        writeBulk(values, count, iter, NeedSwap<T>());
+    }
+
+private:
+    template <typename T>
+    static void swapInPlace(T* values, std::size_t count, std::false_type)
+    {
+        static_cast<void>(values);
+        static_cast<void>(count);
+    }
+
+    // Simple loop over the contiguous array, vectorised by the compiler
+    // when SIMD instructions are available.
+    template <typename T>
+    static void swapInPlace(T* values, std::size_t count, std::true_type)
+    {
+        typedef BulkAccessWord<sizeof(T)> Word;
+        typedef typename Word::Type WordType;
+        for (std::size_t idx = 0; idx < count; ++idx) {
+            values[idx] =
+                static_cast<T>(Word::swap(static_cast<WordType>(values[idx])));
+        }
+    }
+
+    template <typename T, typename TIter>
+    static void writeBulk(const T* values, std::size_t count, TIter& iter, std::false_type)
+    {
+        std::memcpy(iter, values, count * sizeof(T));
+        iter += count * sizeof(T);
+    }
+
+    template <typename T, typename TIter>
+    static void writeBulk(const T* values, std::size_t count, TIter& iter, std::true_type)
+    {
+        typedef BulkAccessWord<sizeof(T)> Word;
+        typedef typename Word::Type WordType;
+        for (std::size_t idx = 0; idx < count; ++idx) {
+            auto word = Word::swap(static_cast<WordType>(values[idx]));
+            std::memcpy(iter, &word, sizeof(word));
+            iter += sizeof(word);
+        }
+    }
+#endif // #ifdef EMBXX_IO_BULK_ACCESS
 };
 
 }  // namespace details
@@ -779,6 +1091,35 @@ T readData(TIter& iter, const traits::endian::Little& endian)
     return readLittle<T, TSize>(iter);
 }
 
+template <typename T, typename TIter, typename TEndian>
+void readDataArray(
+    T* values,
+    std::size_t count,
+    TIter& iter,
+    const TEndian& endian)
+{
+    static_cast<void>(endian);
+    static_assert(std::is_integral<T>::value, "T must be integral type");
+    typedef std::integral_constant<
+        bool,
+        details::IsBulkArrayAccessible<TIter, T>::Value> BulkTag;
+    details::ArrayAccess<TEndian>::read(values, count, iter, BulkTag());
+}
+
+template <typename T, typename TIter, typename TEndian>
+void writeDataArray(
+    const T* values,
+    std::size_t count,
+    TIter& iter,
+    const TEndian& endian)
+{
+    static_cast<void>(endian);
+    static_assert(std::is_integral<T>::value, "T must be integral type");
+    typedef std::integral_constant<
+        bool,
+        details::IsBulkArrayAccessible<TIter, T>::Value> BulkTag;
+    details::ArrayAccess<TEndian>::write(values, count, iter, BulkTag());
+}
 
 }  // namespace io
 
@@ -0,0 +1,163 @@
+//
+// Copyright 2014 (C). Alex Robenko. All rights reserved.
+//
+
+// This library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file embxx/util/AllocStats.h
+/// This file contains definition of allocation statistics policies.
+
+#pragma once
+
+#include <cstddef>
+
+#include "embxx/util/Assert.h"
+
+namespace embxx
+{
+
+namespace util
+{
+
+/// @addtogroup util
+/// @{
+
+/// @brief Snapshot of allocation statistics.
+/// @details The allocation/deallocation rates can be calculated as difference
+///          between allocCount/deallocCount values of two snapshots taken
+///          at known time interval.
+/// @headerfile embxx/util/AllocStats.h
+struct AllocStatsSnapshot
+{
+    std::size_t current = 0U; ///< Number of currently allocated cells
+    std::size_t peak = 0U; ///< Maximal number of cells allocated at the same time
+    std::size_t allocCount = 0U; ///< Number of successful allocations
+    std::size_t deallocCount = 0U; ///< Number of deallocations
+    std::size_t failedCount = 0U; ///< Number of failed allocations
+    std::size_t searchLength = 0U; ///< Accumulated search length of all allocation attempts
+
+    /// @brief Get average search length of single allocation attempt.
+    std::size_t averageSearchLength() const
+    {
+        auto attempts = allocCount + failedCount;
+        if (attempts == 0U) {
+            return 0U;
+        }
+        return searchLength / attempts;
+    }
+};
+
+/// @brief Allocation statistics policy that doesn't record anything.
+/// @details Default statistics policy of the allocators, all the
+///          member functions are empty and optimised away by the compiler.
+/// @headerfile embxx/util/AllocStats.h
+class NoAllocStats
+{
+public:
+    /// @brief Record successful allocation.
+    void allocated(std::size_t count, std::size_t searchLength)
+    {
+        static_cast<void>(count);
+        static_cast<void>(searchLength);
+    }
+
+    /// @brief Record failed allocation.
+    void allocFailed(std::size_t searchLength)
+    {
+        static_cast<void>(searchLength);
+    }
+
+    /// @brief Record deallocation.
+    void deallocated(std::size_t count)
+    {
+        static_cast<void>(count);
+    }
+
+    /// @brief Get statistics snapshot, always empty.
+    AllocStatsSnapshot snapshot() const
+    {
+        return AllocStatsSnapshot();
+    }
+
+    /// @brief Reset statistics, does nothing.
+    void reset()
+    {
+    }
+};
+
+/// @brief Allocation statistics policy that records allocation statistics.
+/// @details Pass it as TStats template parameter to the allocator and
+///          use stats().snapshot() of the allocator to read the statistics.
+/// @note Thread safety: Unsafe, the updates are performed in the context
+///       of allocator's allocation/deallocation functions.
+/// @headerfile embxx/util/AllocStats.h
+class AllocStats
+{
+public:
+    /// @brief Record successful allocation.
+    /// @param count Number of allocated cells.
+    /// @param searchLength Number of steps performed to find free space.
+    void allocated(std::size_t count, std::size_t searchLength)
+    {
+        stats_.current += count;
+        if (stats_.peak < stats_.current) {
+            stats_.peak = stats_.current;
+        }
+        ++stats_.allocCount;
+        stats_.searchLength += searchLength;
+    }
+
+    /// @brief Record failed allocation.
+    /// @param searchLength Number of steps performed trying to find free space.
+    void allocFailed(std::size_t searchLength)
+    {
+        ++stats_.failedCount;
+        stats_.searchLength += searchLength;
+    }
+
+    /// @brief Record deallocation.
+    /// @param count Number of released cells.
+    void deallocated(std::size_t count)
+    {
+        GASSERT(count <= stats_.current);
+        stats_.current -= count;
+        ++stats_.deallocCount;
+    }
+
+    /// @brief Get statistics snapshot.
+    AllocStatsSnapshot snapshot() const
+    {
+        return stats_;
+    }
+
+    /// @brief Reset all the counters.
+    /// @details Number of currently allocated cells is preserved, peak
+    ///          usage is reset to current one.
+    void reset()
+    {
+        auto current = stats_.current;
+        stats_ = AllocStatsSnapshot();
+        stats_.current = current;
+        stats_.peak = current;
+    }
+
+private:
+    AllocStatsSnapshot stats_;
+};
+
+/// @}
+
+}  // namespace util
+
+}  // namespace embxx
@@ -25,10 +25,15 @@
 #include <memory>
 #include <type_traits>
 #include <tuple>
+#include <array>
+#include <mutex>
+#include <utility>
 
 #include "embxx/util/Assert.h"
 #include "embxx/util/AlignedUnion.h"
 #include "embxx/util/Tuple.h"
+#include "embxx/util/AllocStats.h"
+#include "embxx/util/IntrusivePtr.h"
 
 namespace embxx
 {
@@ -65,8 +70,13 @@ public:
 ///          the allocated object. This allocator is unsafe, it expects pointer
 ///          to the allocation space to be provided and doesn't check
 ///          alignment or size errors for the allocated objects.
+/// @tparam TStats Allocation statistics policy, see embxx::util::AllocStats.
+///         By default (embxx::util::NoAllocStats) nothing is recorded.
+///         The allocator privately inherits from the policy, so the empty
+///         one doesn't increase the size of the allocator.
 /// @headerfile embxx/util/Allocators.h
-class BasicInPlaceAllocator
+template <typename TStats = NoAllocStats>
+class GenericBasicInPlaceAllocator : private TStats
 {
 public:
 
@@ -80,9 +90,9 @@ public:
         friend class Deleter;
 
     public:
-        /// Constructor used by BasicInPlaceAllocator to create std::unique_ptr
-        Deleter(bool* allocated = nullptr)
-            : allocated_(allocated)
+        /// Constructor used by GenericBasicInPlaceAllocator to create std::unique_ptr
+        Deleter(GenericBasicInPlaceAllocator* owner = nullptr)
+            : owner_(owner)
         {
         }
 
@@ -91,7 +101,7 @@ public:
 
         template <typename U>
         Deleter(Deleter<U>&& other)
-            : allocated_(other.allocated_)
+            : owner_(other.owner_)
         {
             static_assert(std::is_base_of<T, U>::value ||
                           std::is_base_of<U, T>::value ||
@@ -100,12 +110,12 @@ public:
                 "To make Deleter convertible, their template parameters "
                 "must be convertible.");
 
-            other.allocated_ = nullptr;
+            other.owner_ = nullptr;
         }
 
         ~Deleter()
         {
-            GASSERT(allocated_ == nullptr);
+            GASSERT(owner_ == nullptr);
         }
 
         /// Copy assignment is deleted
@@ -125,24 +135,23 @@ public:
                 return *this;
             }
 
-            GASSERT(allocated_ == nullptr);
-            allocated_ = other.allocated_;
-            other.allocated_ = nullptr;
+            GASSERT(owner_ == nullptr);
+            owner_ = other.owner_;
+            other.owner_ = nullptr;
             return *this;
         }
 
         /// @brief Deletion operator
         /// @details Executes destructor of the deleted object
         void operator()(T* obj) {
-            GASSERT(allocated_ != nullptr);
-            GASSERT(*allocated_);
+            GASSERT(owner_ != nullptr);
             obj->~T();
-            *allocated_ = false;
-            allocated_ = nullptr;
+            owner_->release();
+            owner_ = nullptr;
         }
 
     private:
-        bool* allocated_;
+        GenericBasicInPlaceAllocator* owner_;
     };
     /// @endcond
 
@@ -151,14 +160,14 @@ public:
     /// @param place Pointer to a space where allocation should happen. If
     ///              0 (default) every allocation will fail until
     ///              setAllocPlace() with valid pointer is called.
-    BasicInPlaceAllocator(void* place = 0)
+    GenericBasicInPlaceAllocator(void* place = 0)
         : place_(place),
           allocated_(false)
     {
     }
 
     /// Destructor
-    ~BasicInPlaceAllocator()
+    ~GenericBasicInPlaceAllocator()
     {
         GASSERT(!allocated_);
     }
@@ -188,16 +197,44 @@ public:
         if ((place_ != nullptr) && (!allocated_)) {
             ptr.reset(new (place_) TObj(std::forward<TArgs>(args)...));
             allocated_ = true;
-            ptr.get_deleter() = Del(&allocated_);
+            ptr.get_deleter() = Del(this);
+            stats().allocated(1U, 1U);
+        }
+        else {
+            stats().allocFailed(1U);
         }
         return std::move(ptr);
     }
 
+    /// @brief Get access to allocation statistics.
+    const TStats& stats() const
+    {
+        return *this;
+    }
+
+    /// @brief Get access to allocation statistics.
+    TStats& stats()
+    {
+        return *this;
+    }
+
 private:
+    void release()
+    {
+        GASSERT(allocated_);
+        allocated_ = false;
+        stats().deallocated(1U);
+    }
+
     void* place_;
     bool allocated_;
 };
 
+/// @brief Object allocation policy that uses "in place" object construction.
+/// @details Same as GenericBasicInPlaceAllocator without any statistics recorded.
+/// @headerfile embxx/util/Allocators.h
+typedef GenericBasicInPlaceAllocator<> BasicInPlaceAllocator;
+
 /// @brief Object allocation policy that uses "in place" object construction.
 /// @details Much safer "in place" allocator than BasicInPlaceAllocator. It
 ///          allocates required space with required alignment as private
@@ -206,15 +243,17 @@ private:
 /// @tparam TSize Required size.
 /// @tparam TAlignment Required alignment. By default the alignment will
 ///         be the same as alignment of "double", usually 8 bytes.
+/// @tparam TStats Allocation statistics policy, see embxx::util::AllocStats.
 /// @headerfile embxx/util/Allocators.h
 template <std::size_t TSize,
-          std::size_t TAlignment = std::alignment_of<double>::value>
+          std::size_t TAlignment = std::alignment_of<double>::value,
+          typename TStats = NoAllocStats>
 class InPlaceAllocator
 {
 public:
 
-    /// Using BasicInPlaceAllocator
-    typedef BasicInPlaceAllocator Allocator;
+    /// Using GenericBasicInPlaceAllocator
+    typedef GenericBasicInPlaceAllocator<TStats> Allocator;
 
     /// Constructor
     InPlaceAllocator()
@@ -231,7 +270,7 @@ public:
     /// @pre sizeof(TObj) <= TSize
     /// @pre std::alignment_of<TObj>::value <= TAlignment.
     template <typename TObj, typename... TArgs>
-    auto alloc(TArgs&&... args) -> decltype(BasicInPlaceAllocator().alloc<TObj>(std::forward<TArgs>(args)...))
+    auto alloc(TArgs&&... args) -> decltype(Allocator().template alloc<TObj>(std::forward<TArgs>(args)...))
     {
         static_assert(sizeof(TObj) <= sizeof(place_),
                                 "Must be enough space for allocation");
@@ -240,12 +279,24 @@ public:
                                 "Failed alignment requirements");
 
 
-        return allocator_.alloc<TObj>(std::forward<TArgs>(args)...);
+        return allocator_.template alloc<TObj>(std::forward<TArgs>(args)...);
+    }
+
+    /// @brief Get access to allocation statistics.
+    const TStats& stats() const
+    {
+        return allocator_.stats();
+    }
+
+    /// @brief Get access to allocation statistics.
+    TStats& stats()
+    {
+        return allocator_.stats();
     }
 
 private:
     typename std::aligned_storage<TSize, TAlignment>::type place_;
-    BasicInPlaceAllocator allocator_;
+    Allocator allocator_;
 };
 
 /// @brief Object allocation policy that uses "in place" object construction.
@@ -255,8 +306,9 @@ private:
 ///          and uses InPlaceAllocator for the allocations.
 /// @tparam TTuple std::tuple<...> with all the types this allocator can
 ///         allocate
+/// @tparam TStats Allocation statistics policy, see embxx::util::AllocStats.
 /// @headerfile embxx/util/Allocators.h
-template <typename TTuple>
+template <typename TTuple, typename TStats = NoAllocStats>
 class SpecificInPlaceAllocator
 {
     static_assert(IsTuple<TTuple>::Value, "TTuple must be std::tuple");
@@ -265,7 +317,10 @@ class SpecificInPlaceAllocator
 public:
 
     /// Using InPlaceAllocator
-    typedef InPlaceAllocator<sizeof(AlignedStorage), std::alignment_of<AlignedStorage>::value> Allocator;
+    typedef InPlaceAllocator<
+        sizeof(AlignedStorage),
+        std::alignment_of<AlignedStorage>::value,
+        TStats> Allocator;
 
     /// @brief Allocation function
     /// @details Uses in place object construction
@@ -280,7 +335,502 @@ public:
         static_assert(IsInTuple<TObj, TTuple>::Value,
                     "TObj must be included in TTuple");
 
-        return allocator_.alloc<TObj>(std::forward<TArgs>(args)...);
+        return allocator_.template alloc<TObj>(std::forward<TArgs>(args)...);
+    }
+
+    /// @brief Get access to allocation statistics.
+    const TStats& stats() const
+    {
+        return allocator_.stats();
+    }
+
+    /// @brief Get access to allocation statistics.
+    TStats& stats()
+    {
+        return allocator_.stats();
+    }
+
+private:
+    Allocator allocator_;
+};
+
+/// @cond DOCUMENT_ASSERT_MANAGER
+namespace details
+{
+
+struct PoolInPlaceAllocatorNoLock
+{
+    void lock() {}
+    void unlock() {}
+};
+
+template <std::size_t TCount, typename TLock>
+class PoolInPlaceFreeList
+{
+public:
+    PoolInPlaceFreeList()
+        : head_(0U),
+          allocatedCount_(0U)
+    {
+        for (auto idx = 0U; idx < TCount; ++idx) {
+            next_[idx] = idx + 1;
+        }
+    }
+
+    ~PoolInPlaceFreeList()
+    {
+        GASSERT(allocatedCount_ == 0U);
+    }
+
+    std::size_t acquire()
+    {
+        std::lock_guard<TLock> guard(lock_);
+        auto idx = head_;
+        if (idx < TCount) {
+            head_ = next_[idx];
+            ++allocatedCount_;
+        }
+        return idx;
+    }
+
+    void release(std::size_t idx)
+    {
+        GASSERT(idx < TCount);
+        std::lock_guard<TLock> guard(lock_);
+        GASSERT(0U < allocatedCount_);
+        next_[idx] = head_;
+        head_ = idx;
+        --allocatedCount_;
+    }
+
+    std::size_t allocatedCount() const
+    {
+        std::lock_guard<TLock> guard(lock_);
+        return allocatedCount_;
+    }
+
+private:
+    std::array<std::size_t, TCount> next_;
+    std::size_t head_;
+    std::size_t allocatedCount_;
+    mutable TLock lock_;
+};
+
+}  // namespace details
+/// @endcond
+
+/// @brief Object allocation policy that uses "in place" object construction
+///        in one of several pre-allocated slots.
+/// @details Similar to InPlaceAllocator, but allows up to TCount objects to
+///          be allocated at the same time. The free slots are managed by
+///          the free list, both allocation and deallocation take constant
+///          time. The newly created object is returned wrapped in
+///          std::unique_ptr with a deleter that calls destructor of
+///          the object and returns the slot back to the pool.
+/// @tparam TSize Size of single slot.
+/// @tparam TCount Number of slots.
+/// @tparam TAlignment Required alignment. By default the alignment will
+///         be the same as alignment of "double", usually 8 bytes.
+/// @tparam TLock "Lockable" class (such as std::mutex) used to protect the
+///         free list when the objects are allocated and released in different
+///         threads. By default no locking is performed.
+/// @headerfile embxx/util/Allocators.h
+template <std::size_t TSize,
+          std::size_t TCount,
+          std::size_t TAlignment = std::alignment_of<double>::value,
+          typename TLock = details::PoolInPlaceAllocatorNoLock>
+class PoolInPlaceAllocator
+{
+    static_assert(0U < TCount, "Number of slots must be greater than 0");
+
+public:
+
+    /// @cond DOCUMENT_ASSERT_MANAGER
+
+    /// @brief Deleter class
+    template <typename T>
+    class Deleter
+    {
+        template<typename U>
+        friend class Deleter;
+
+    public:
+        /// Constructor used by PoolInPlaceAllocator to create std::unique_ptr
+        Deleter(PoolInPlaceAllocator* pool = nullptr, std::size_t idx = TCount)
+            : pool_(pool),
+              idx_(idx)
+        {
+        }
+
+        /// Copy constructor is deleted
+        Deleter(const Deleter& other) = delete;
+
+        template <typename U>
+        Deleter(Deleter<U>&& other)
+            : pool_(other.pool_),
+              idx_(other.idx_)
+        {
+            static_assert(std::is_base_of<T, U>::value ||
+                          std::is_base_of<U, T>::value ||
+                          std::is_convertible<U, T>::value ||
+                          std::is_convertible<T, U>::value ,
+                "To make Deleter convertible, their template parameters "
+                "must be convertible.");
+
+            other.pool_ = nullptr;
+            other.idx_ = TCount;
+        }
+
+        ~Deleter()
+        {
+            GASSERT(pool_ == nullptr);
+        }
+
+        /// Copy assignment is deleted
+        Deleter& operator=(const Deleter& other) = delete;
+
+        template <typename U>
+        Deleter& operator=(Deleter<U>&& other)
+        {
+            static_assert(std::is_base_of<T, U>::value ||
+                          std::is_base_of<U, T>::value ||
+                          std::is_convertible<U, T>::value ||
+                          std::is_convertible<T, U>::value ,
+                "To make Deleter convertible, their template parameters "
+                "must be convertible.");
+
+            if (reinterpret_cast<void*>(this) == reinterpret_cast<const void*>(&other)) {
+                return *this;
+            }
+
+            GASSERT(pool_ == nullptr);
+            pool_ = other.pool_;
+            idx_ = other.idx_;
+            other.pool_ = nullptr;
+            other.idx_ = TCount;
+            return *this;
+        }
+
+        /// @brief Deletion operator
+        /// @details Executes destructor of the deleted object and returns
+        ///          its slot to the pool.
+        void operator()(T* obj) {
+            GASSERT(pool_ != nullptr);
+            obj->~T();
+            pool_->freeList_.release(idx_);
+            pool_ = nullptr;
+            idx_ = TCount;
+        }
+
+    private:
+        PoolInPlaceAllocator* pool_;
+        std::size_t idx_;
+    };
+    /// @endcond
+
+    /// Constructor
+    PoolInPlaceAllocator() = default;
+
+    /// Copy constructor is deleted
+    PoolInPlaceAllocator(const PoolInPlaceAllocator&) = delete;
+
+    /// Destructor
+    ~PoolInPlaceAllocator() = default;
+
+    /// Copy assignment is deleted
+    PoolInPlaceAllocator& operator=(const PoolInPlaceAllocator&) = delete;
+
+    /// @brief Allocation function
+    /// @details Uses in place object construction in the first free slot
+    /// @tparam TObj Type of object to by constructed
+    /// @tparam TArgs Types of the parameters required to create an object.
+    /// @return std::unique_ptr to constructed object with custom deleter that
+    ///         calls the destructor of the object and releases the slot. The
+    ///         returned pointer is empty if all the slots are in use.
+    /// @pre sizeof(TObj) <= TSize
+    /// @pre std::alignment_of<TObj>::value <= TAlignment.
+    template <typename TObj, typename... TArgs>
+    std::unique_ptr<TObj, Deleter<TObj> > alloc(TArgs&&... args)
+    {
+        static_assert(sizeof(TObj) <= sizeof(Slot),
+                                "Must be enough space for allocation");
+
+        static_assert(std::alignment_of<TObj>::value <= TAlignment,
+                                "Failed alignment requirements");
+
+        typedef Deleter<TObj> Del;
+        std::unique_ptr<TObj, Del> ptr(nullptr, Del());
+        auto idx = freeList_.acquire();
+        if (idx < TCount) {
+            ptr.reset(new (&slots_[idx]) TObj(std::forward<TArgs>(args)...));
+            ptr.get_deleter() = Del(this, idx);
+        }
+        return ptr;
+    }
+
+    /// @brief Get number of currently allocated objects.
+    std::size_t allocatedCount() const
+    {
+        return freeList_.allocatedCount();
+    }
+
+private:
+    typedef typename std::aligned_storage<TSize, TAlignment>::type Slot;
+
+    std::array<Slot, TCount> slots_;
+    details::PoolInPlaceFreeList<TCount, TLock> freeList_;
+};
+
+/// @brief Object allocation policy that uses "in place" object construction
+///        in one of several pre-allocated slots.
+/// @details It receives all the types it can allocate wrapped in std::tuple
+///          in single template parameter, calculates the required size and
+///          alignment to be able to safely allocated any of the required types
+///          and uses PoolInPlaceAllocator for the allocations.
+/// @tparam TTuple std::tuple<...> with all the types this allocator can
+///         allocate
+/// @tparam TCount Number of objects that may be allocated at the same time.
+/// @tparam TLock "Lockable" class, see PoolInPlaceAllocator.
+/// @headerfile embxx/util/Allocators.h
+template <typename TTuple,
+          std::size_t TCount,
+          typename TLock = details::PoolInPlaceAllocatorNoLock>
+class SpecificPoolInPlaceAllocator
+{
+    static_assert(IsTuple<TTuple>::Value, "TTuple must be std::tuple");
+    typedef typename TupleAsAlignedUnion<TTuple>::Type AlignedStorage;
+
+public:
+
+    /// Using PoolInPlaceAllocator
+    typedef PoolInPlaceAllocator<
+        sizeof(AlignedStorage),
+        TCount,
+        std::alignment_of<AlignedStorage>::value,
+        TLock> Allocator;
+
+    /// @brief Allocation function
+    /// @details Uses in place object construction
+    /// @tparam TObj Type of object to by constructed
+    /// @tparam TArgs Types of the parameters required to create an object.
+    /// @return std::unique_ptr to constructed object with custom deleter that
+    ///         calls the destructor of the object and releases the slot.
+    /// @pre TObj was included in TTuple.
+    template <typename TObj, typename... TArgs>
+    auto alloc(TArgs&&... args) -> decltype(std::declval<Allocator&>().template alloc<TObj>(std::forward<TArgs>(args)...))
+    {
+        static_assert(IsInTuple<TObj, TTuple>::Value,
+                    "TObj must be included in TTuple");
+
+        return allocator_.template alloc<TObj>(std::forward<TArgs>(args)...);
+    }
+
+    /// @brief Get number of currently allocated objects.
+    std::size_t allocatedCount() const
+    {
+        return allocator_.allocatedCount();
+    }
+
+private:
+    Allocator allocator_;
+};
+
+/// @brief Object allocation policy that uses "in place" object construction
+///        in one of several pre-allocated slots and returns reference
+///        counting pointer.
+/// @details Similar to PoolInPlaceAllocator, but the newly created object
+///          is returned wrapped in embxx::util::IntrusivePtr. The reference
+///          counter resides in the control block of the slot, the pointer
+///          can be copied (for example to be delivered to several handlers)
+///          without copying the object itself. The object is destructed and
+///          the slot is returned to the pool when the last pointer is
+///          destructed.
+/// @tparam TSize Size of single slot.
+/// @tparam TCount Number of slots.
+/// @tparam TAlignment Required alignment. By default the alignment will
+///         be the same as alignment of "double", usually 8 bytes.
+/// @tparam TRefCount Type of the reference counter. Use std::size_t (default)
+///         when all the pointers to the same object are used in single
+///         thread and std::atomic<std::size_t> otherwise.
+/// @tparam TLock "Lockable" class (such as std::mutex) used to protect the
+///         free list when the objects are allocated and released in different
+///         threads. By default no locking is performed.
+/// @headerfile embxx/util/Allocators.h
+template <std::size_t TSize,
+          std::size_t TCount,
+          std::size_t TAlignment = std::alignment_of<double>::value,
+          typename TRefCount = std::size_t,
+          typename TLock = details::PoolInPlaceAllocatorNoLock>
+class RefCountedPoolAllocator
+{
+    static_assert(0U < TCount, "Number of slots must be greater than 0");
+
+public:
+
+    /// @brief Control block of the slot.
+    class Ctrl
+    {
+        friend class RefCountedPoolAllocator;
+
+    public:
+        /// @brief Increment reference counter.
+        void addRef()
+        {
+            ++count_;
+        }
+
+        /// @brief Decrement reference counter, destruct the object and
+        ///        release the slot when the counter reaches 0.
+        void release()
+        {
+            GASSERT(0U < useCount());
+            if (--count_ == 0U) {
+                pool_->dispose(*this);
+            }
+        }
+
+        /// @brief Get current value of the reference counter.
+        std::size_t useCount() const
+        {
+            return count_;
+        }
+
+    private:
+        typedef void (*DestroyFunc)(void*);
+
+        TRefCount count_;
+        DestroyFunc destroy_;
+        RefCountedPoolAllocator* pool_;
+    };
+
+    /// Constructor
+    RefCountedPoolAllocator()
+    {
+        for (auto& ctrl : ctrls_) {
+            ctrl.count_ = 0U;
+            ctrl.destroy_ = nullptr;
+            ctrl.pool_ = this;
+        }
+    }
+
+    /// Copy constructor is deleted
+    RefCountedPoolAllocator(const RefCountedPoolAllocator&) = delete;
+
+    /// Destructor
+    ~RefCountedPoolAllocator() = default;
+
+    /// Copy assignment is deleted
+    RefCountedPoolAllocator& operator=(const RefCountedPoolAllocator&) = delete;
+
+    /// @brief Allocation function
+    /// @details Uses in place object construction in the first free slot
+    /// @tparam TObj Type of object to by constructed
+    /// @tparam TArgs Types of the parameters required to create an object.
+    /// @return embxx::util::IntrusivePtr to constructed object. The returned
+    ///         pointer is empty if all the slots are in use.
+    /// @pre sizeof(TObj) <= TSize
+    /// @pre std::alignment_of<TObj>::value <= TAlignment.
+    template <typename TObj, typename... TArgs>
+    IntrusivePtr<TObj, Ctrl> alloc(TArgs&&... args)
+    {
+        static_assert(sizeof(TObj) <= sizeof(Slot),
+                                "Must be enough space for allocation");
+
+        static_assert(std::alignment_of<TObj>::value <= TAlignment,
+                                "Failed alignment requirements");
+
+        typedef IntrusivePtr<TObj, Ctrl> Ptr;
+        auto idx = freeList_.acquire();
+        if (TCount <= idx) {
+            return Ptr();
+        }
+
+        auto* obj = new (&slots_[idx]) TObj(std::forward<TArgs>(args)...);
+        auto& ctrl = ctrls_[idx];
+        ctrl.count_ = 1U;
+        ctrl.destroy_ = &RefCountedPoolAllocator::template destroyObj<TObj>;
+        return Ptr(obj, &ctrl);
+    }
+
+    /// @brief Get number of currently allocated objects.
+    std::size_t allocatedCount() const
+    {
+        return freeList_.allocatedCount();
+    }
+
+private:
+    typedef typename std::aligned_storage<TSize, TAlignment>::type Slot;
+
+    template <typename TObj>
+    static void destroyObj(void* obj)
+    {
+        reinterpret_cast<TObj*>(obj)->~TObj();
+    }
+
+    void dispose(Ctrl& ctrl)
+    {
+        auto idx = static_cast<std::size_t>(&ctrl - &ctrls_[0]);
+        GASSERT(idx < TCount);
+        GASSERT(ctrl.destroy_ != nullptr);
+        ctrl.destroy_(&slots_[idx]);
+        ctrl.destroy_ = nullptr;
+        freeList_.release(idx);
+    }
+
+    std::array<Slot, TCount> slots_;
+    std::array<Ctrl, TCount> ctrls_;
+    details::PoolInPlaceFreeList<TCount, TLock> freeList_;
+};
+
+/// @brief Reference counting version of SpecificPoolInPlaceAllocator.
+/// @details It receives all the types it can allocate wrapped in std::tuple
+///          in single template parameter, calculates the required size and
+///          alignment to be able to safely allocated any of the required types
+///          and uses RefCountedPoolAllocator for the allocations.
+/// @tparam TTuple std::tuple<...> with all the types this allocator can
+///         allocate
+/// @tparam TCount Number of objects that may be allocated at the same time.
+/// @tparam TRefCount Type of the reference counter, see RefCountedPoolAllocator.
+/// @tparam TLock "Lockable" class, see RefCountedPoolAllocator.
+/// @headerfile embxx/util/Allocators.h
+template <typename TTuple,
+          std::size_t TCount,
+          typename TRefCount = std::size_t,
+          typename TLock = details::PoolInPlaceAllocatorNoLock>
+class SpecificRefCountedPoolAllocator
+{
+    static_assert(IsTuple<TTuple>::Value, "TTuple must be std::tuple");
+    typedef typename TupleAsAlignedUnion<TTuple>::Type AlignedStorage;
+
+public:
+
+    /// Using RefCountedPoolAllocator
+    typedef RefCountedPoolAllocator<
+        sizeof(AlignedStorage),
+        TCount,
+        std::alignment_of<AlignedStorage>::value,
+        TRefCount,
+        TLock> Allocator;
+
+    /// @brief Allocation function
+    /// @details Uses in place object construction
+    /// @tparam TObj Type of object to by constructed
+    /// @tparam TArgs Types of the parameters required to create an object.
+    /// @return embxx::util::IntrusivePtr to constructed object.
+    /// @pre TObj was included in TTuple.
+    template <typename TObj, typename... TArgs>
+    IntrusivePtr<TObj, typename Allocator::Ctrl> alloc(TArgs&&... args)
+    {
+        static_assert(IsInTuple<TObj, TTuple>::Value,
+                    "TObj must be included in TTuple");
+
+        return allocator_.template alloc<TObj>(std::forward<TArgs>(args)...);
+    }
+
+    /// @brief Get number of currently allocated objects.
+    std::size_t allocatedCount() const
+    {
+        return allocator_.allocatedCount();
     }
 
 private:
@@ -0,0 +1,413 @@
+//
+// Copyright 2014 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file embxx/util/ConcurrentStaticPoolAllocator.h
+/// This file contains definition of thread safe static pool allocator.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <array>
+#include <atomic>
+#include <iterator>
+#include <limits>
+
+#include "embxx/util/Assert.h"
+#include "embxx/util/SizeToType.h"
+
+namespace embxx
+{
+
+namespace util
+{
+
+namespace details
+{
+
+template <typename TTag, typename T, std::size_t TSize>
+struct ConcurrentStaticPoolAllocatorStorage
+{
+    typedef typename
+        std::aligned_storage<
+            sizeof(T),
+            std::alignment_of<T>::value
+        >::type CellType;
+
+    // 16 bit index and 16 bit tag are packed into 32 bit head when the pool
+    // is small enough, 32 bit ones into 64 bit head otherwise.
+    static const std::size_t IndexSize =
+        (TSize < std::numeric_limits<std::uint16_t>::max()) ? 2 : 4;
+
+    typedef typename SizeToType<IndexSize>::Type IndexType;
+    typedef typename SizeToType<IndexSize * 2>::Type HeadType;
+
+    static_assert(TSize < std::numeric_limits<IndexType>::max(),
+        "The pool is too big");
+
+    static_assert(
+        (sizeof(HeadType) <= sizeof(int)) ?
+            (ATOMIC_INT_LOCK_FREE == 2) :
+            (ATOMIC_LLONG_LOCK_FREE == 2),
+        "Atomic operations on the list head are not lock-free on this platform, "
+        "reduce the pool size below 0xffff cells");
+
+    static const IndexType NullIndex = 0U;
+    static const unsigned TagShift = std::numeric_limits<IndexType>::digits;
+
+    // Encodes (index + 1) in the lower half and ABA protection tag in
+    // the upper one, zero means empty list.
+    static std::atomic<HeadType> head_;
+
+    // Number of cells that have never been handed out, they are
+    // not in the free list.
+    static std::atomic<IndexType> untouched_;
+
+    // Links of the free list, (index + 1) of the next free cell
+    static std::array<std::atomic<IndexType>, TSize> next_;
+
+    static std::array<CellType, TSize> items_;
+
+    static IndexType pop()
+    {
+        auto head = head_.load(std::memory_order_acquire);
+        while (true) {
+            auto encodedIdx = static_cast<IndexType>(head);
+            if (encodedIdx == NullIndex) {
+                break;
+            }
+
+            auto idx = static_cast<IndexType>(encodedIdx - 1);
+            auto nextEncodedIdx = next_[idx].load(std::memory_order_relaxed);
+            auto tag = (head >> TagShift) + 1;
+            auto newHead = (tag << TagShift) | static_cast<HeadType>(nextEncodedIdx);
+            if (head_.compare_exchange_weak(
+                    head,
+                    newHead,
+                    std::memory_order_acquire,
+                    std::memory_order_acquire)) {
+                return idx;
+            }
+        }
+
+        auto untouched = untouched_.load(std::memory_order_relaxed);
+        while (untouched < TSize) {
+            if (untouched_.compare_exchange_weak(
+                    untouched,
+                    static_cast<IndexType>(untouched + 1),
+                    std::memory_order_relaxed,
+                    std::memory_order_relaxed)) {
+                return untouched;
+            }
+        }
+
+        return static_cast<IndexType>(TSize);
+    }
+
+    static void push(IndexType idx)
+    {
+        GASSERT(idx < TSize);
+        auto head = head_.load(std::memory_order_relaxed);
+        while (true) {
+            next_[idx].store(static_cast<IndexType>(head), std::memory_order_relaxed);
+            auto tag = (head >> TagShift) + 1;
+            auto newHead = (tag << TagShift) | static_cast<HeadType>(idx + 1);
+            if (head_.compare_exchange_weak(
+                    head,
+                    newHead,
+                    std::memory_order_release,
+                    std::memory_order_relaxed)) {
+                break;
+            }
+        }
+    }
+};
+
+template <typename TTag, typename T, std::size_t TSize>
+std::atomic<typename ConcurrentStaticPoolAllocatorStorage<TTag, T, TSize>::HeadType>
+ConcurrentStaticPoolAllocatorStorage<TTag, T, TSize>::head_(0U);
+
+template <typename TTag, typename T, std::size_t TSize>
+std::atomic<typename ConcurrentStaticPoolAllocatorStorage<TTag, T, TSize>::IndexType>
+ConcurrentStaticPoolAllocatorStorage<TTag, T, TSize>::untouched_(0U);
+
+template <typename TTag, typename T, std::size_t TSize>
+std::array<
+    std::atomic<typename ConcurrentStaticPoolAllocatorStorage<TTag, T, TSize>::IndexType>,
+    TSize>
+ConcurrentStaticPoolAllocatorStorage<TTag, T, TSize>::next_;
+
+template <typename TTag, typename T, std::size_t TSize>
+std::array<
+    typename ConcurrentStaticPoolAllocatorStorage<TTag, T, TSize>::CellType,
+    TSize>
+ConcurrentStaticPoolAllocatorStorage<TTag, T, TSize>::items_;
+
+template <typename TStorage, std::size_t TMagazineSize>
+class ConcurrentStaticPoolAllocatorMagazine
+{
+public:
+    typedef typename TStorage::IndexType IndexType;
+
+    ~ConcurrentStaticPoolAllocatorMagazine()
+    {
+        while (0U < count_) {
+            --count_;
+            TStorage::push(cells_[count_]);
+        }
+    }
+
+    static ConcurrentStaticPoolAllocatorMagazine& instance()
+    {
+        static thread_local ConcurrentStaticPoolAllocatorMagazine magazine;
+        return magazine;
+    }
+
+    IndexType pop()
+    {
+        if (count_ == 0U) {
+            return TStorage::pop();
+        }
+
+        --count_;
+        return cells_[count_];
+    }
+
+    void push(IndexType idx)
+    {
+        if (count_ == TMagazineSize) {
+            // Return half of the cached cells to the shared pool
+            static const std::size_t FlushCount = (TMagazineSize + 1) / 2;
+            for (auto flushIdx = 0U; flushIdx < FlushCount; ++flushIdx) {
+                --count_;
+                TStorage::push(cells_[count_]);
+            }
+        }
+
+        cells_[count_] = idx;
+        ++count_;
+    }
+
+private:
+    std::array<IndexType, TMagazineSize> cells_;
+    std::size_t count_ = 0U;
+};
+
+template <typename TStorage, std::size_t TMagazineSize>
+struct ConcurrentStaticPoolAllocatorCellsSource
+{
+    typedef typename TStorage::IndexType IndexType;
+
+    static IndexType pop()
+    {
+        return ConcurrentStaticPoolAllocatorMagazine<TStorage, TMagazineSize>::instance().pop();
+    }
+
+    static void push(IndexType idx)
+    {
+        ConcurrentStaticPoolAllocatorMagazine<TStorage, TMagazineSize>::instance().push(idx);
+    }
+};
+
+template <typename TStorage>
+struct ConcurrentStaticPoolAllocatorCellsSource<TStorage, 0>
+{
+    typedef typename TStorage::IndexType IndexType;
+
+    static IndexType pop()
+    {
+        return TStorage::pop();
+    }
+
+    static void push(IndexType idx)
+    {
+        TStorage::push(idx);
+    }
+};
+
+}  // namespace details
+
+/// @addtogroup util
+/// @{
+
+/// @brief Thread safe version of StaticPoolAllocator.
+/// @details The cells are kept in the global static storage defined by the
+///          TTag, T and TSize template parameters (same as StaticPoolAllocator).
+///          The free cells are managed by the lock-free list with tagged head
+///          to avoid ABA problem, so the allocator may be shared between
+///          an event loop thread and the producer threads.
+///          For pools of less than 0xffff cells the head packs 16 bit index
+///          and 16 bit tag into 32 bit atomic, which is lock-free on 32 bit
+///          platforms such as Cortex-M. Bigger pools use 64 bit head,
+///          and the compilation fails if the platform doesn't provide
+///          lock-free 64 bit atomic operations.
+///          Only single cell allocations are supported, any request with
+///          num != 1 fails.
+/// @tparam TTag Tag type to distinguish between different pools.
+/// @tparam T Type of allocated object.
+/// @tparam TSize Number of cells in the pool.
+/// @tparam TMagazineSize Number of free cells each thread may cache
+///         locally to avoid contention on the shared list head. 0 (default)
+///         disables the caching. Note that cells cached by one thread are
+///         not available to other threads until the former one releases
+///         half of its cache (when it overflows) or exits.
+/// @headerfile embxx/util/ConcurrentStaticPoolAllocator.h
+template <typename TTag,
+          typename T = void,
+          std::size_t TSize = 1,
+          std::size_t TMagazineSize = 0>
+class ConcurrentStaticPoolAllocator
+{
+    static_assert(
+        std::is_same<typename std::remove_reference<T>::type, T>::value,
+        "Template parameter T to embxx::util::ConcurrentStaticPoolAllocator "
+        "mustn't be reference");
+
+    static_assert(
+        std::is_same<typename std::remove_pointer<T>::type, T>::value,
+        "Template parameter T to embxx::util::ConcurrentStaticPoolAllocator "
+        "mustn't be pointer");
+
+    typedef details::ConcurrentStaticPoolAllocatorStorage<TTag, T, TSize> Storage;
+    typedef details::ConcurrentStaticPoolAllocatorCellsSource<Storage, TMagazineSize> CellsSource;
+
+public:
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    template <typename U>
+    struct rebind
+    {
+        typedef ConcurrentStaticPoolAllocator<TTag, U, TSize, TMagazineSize> other;
+    };
+
+    ConcurrentStaticPoolAllocator() = default;
+    ConcurrentStaticPoolAllocator(const ConcurrentStaticPoolAllocator&) = default;
+    ConcurrentStaticPoolAllocator(ConcurrentStaticPoolAllocator&&) = default;
+    ~ConcurrentStaticPoolAllocator() = default;
+    ConcurrentStaticPoolAllocator& operator=(const ConcurrentStaticPoolAllocator&) = default;
+    ConcurrentStaticPoolAllocator& operator=(ConcurrentStaticPoolAllocator&&) = default;
+
+    /// @brief Allocate single cell.
+    /// @return Pointer to allocated cell, nullptr in case num != 1 or
+    ///         the pool is exhausted.
+    /// @note Thread safety: Safe
+    pointer allocate(size_type num)
+    {
+        if (num != 1U) {
+            return nullptr;
+        }
+
+        auto idx = CellsSource::pop();
+        if (TSize <= idx) {
+            return nullptr;
+        }
+
+        return reinterpret_cast<pointer>(&Storage::items_[idx]);
+    }
+
+    /// @brief Release previously allocated cell.
+    /// @note Thread safety: Safe
+    void deallocate(pointer ptr, size_type num)
+    {
+        static_cast<void>(num);
+        GASSERT(num == 1U);
+        auto& items = Storage::items_;
+        auto idx = std::distance(
+            &items[0],
+            reinterpret_cast<typename Storage::CellType*>(ptr));
+        GASSERT((0 <= idx) && (static_cast<std::size_t>(idx) < items.size()));
+        CellsSource::push(static_cast<typename Storage::IndexType>(idx));
+    }
+
+    constexpr size_type max_size() const
+    {
+        return TSize;
+    }
+
+    template< class U, class... Args >
+    void construct( U* p, Args&&... args )
+    {
+        ::new((void *)p) U(std::forward<Args>(args)...);
+    }
+
+    template< class U>
+    void destroy(U* p)
+    {
+        p->~U();
+    }
+};
+
+template <typename TTag, std::size_t TSize, std::size_t TMagazineSize>
+class ConcurrentStaticPoolAllocator<TTag, void, TSize, TMagazineSize>
+{
+public:
+    typedef void value_type;
+    typedef void* pointer;
+    typedef const void* const_pointer;
+
+    template <typename U>
+    struct rebind
+    {
+        typedef ConcurrentStaticPoolAllocator<TTag, U, TSize, TMagazineSize> other;
+    };
+
+    ConcurrentStaticPoolAllocator() = default;
+    ConcurrentStaticPoolAllocator(const ConcurrentStaticPoolAllocator&) = default;
+    ConcurrentStaticPoolAllocator(ConcurrentStaticPoolAllocator&&) = default;
+    ~ConcurrentStaticPoolAllocator() = default;
+    ConcurrentStaticPoolAllocator& operator=(const ConcurrentStaticPoolAllocator&) = default;
+    ConcurrentStaticPoolAllocator& operator=(ConcurrentStaticPoolAllocator&&) = default;
+};
+
+/// @}
+
+template <typename TTag, typename T, std::size_t TSize, std::size_t TMagazineSize>
+bool operator==(
+    const ConcurrentStaticPoolAllocator<TTag, T, TSize, TMagazineSize>,
+    const ConcurrentStaticPoolAllocator<TTag, T, TSize, TMagazineSize>)
+{
+    return true;
+}
+
+template <typename TTag1, typename T1, std::size_t TSize1, std::size_t TMagazineSize1,
+          typename TTag2, typename T2, std::size_t TSize2, std::size_t TMagazineSize2>
+bool operator==(
+    const ConcurrentStaticPoolAllocator<TTag1, T1, TSize1, TMagazineSize1>,
+    const ConcurrentStaticPoolAllocator<TTag2, T2, TSize2, TMagazineSize2>)
+{
+    return false;
+}
+
+template <typename TTag1, typename T1, std::size_t TSize1, std::size_t TMagazineSize1,
+          typename TTag2, typename T2, std::size_t TSize2, std::size_t TMagazineSize2>
+bool operator!=(
+    const ConcurrentStaticPoolAllocator<TTag1, T1, TSize1, TMagazineSize1> a1,
+    const ConcurrentStaticPoolAllocator<TTag2, T2, TSize2, TMagazineSize2> a2)
+{
+    return !(a1 == a2);
+}
+
+}  // namespace util
+
+}  // namespace embxx
@@ -0,0 +1,137 @@
+//
+// Copyright 2014 (C). Alex Robenko. All rights reserved.
+//
+
+// This library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file embxx/util/FunctionRef.h
+/// Provides FunctionRef class.
+
+#pragma once
+
+#include <type_traits>
+#include <memory>
+#include <utility>
+
+#include "embxx/util/Assert.h"
+
+namespace embxx
+{
+
+namespace util
+{
+
+/// @addtogroup util
+/// @{
+
+/// @brief Generic declaration of FunctionRef.
+/// @details This declaration doesn't have a body, see specialisation.
+/// @headerfile embxx/util/FunctionRef.h
+template <typename TSignature>
+class FunctionRef;
+
+/// @brief Non-owning reference to callable object.
+/// @details Type erased reference to any callable object (functor, lambda,
+///          or plain function) with compatible signature. Unlike StaticFunction
+///          it doesn't store a copy of the functor, only its address and
+///          pointer to invocation function, i.e. size of two pointers.
+///          It is suitable for synchronous callbacks, such as predicates or
+///          visitors, which are invoked only while referenced functor is
+///          still alive. Copying of the FunctionRef object doesn't copy the
+///          referenced functor.
+///
+///          This is template specialisation of the following class definition
+///          @code
+///          // TSignature is a combination of return value an arguments: TRet(TArgs...)
+///          template <typename TSignature>
+///          class FunctionRef;
+///          @endcode
+/// @tparam TRet Return type of the function
+/// @tparam TArgs Argument types
+/// @pre The referenced functor must outlive the FunctionRef object.
+/// @headerfile embxx/util/FunctionRef.h
+template <typename TRet, typename... TArgs>
+class FunctionRef<TRet (TArgs...)>
+{
+    typedef TRet (*FuncPtr)(TArgs...);
+
+public:
+    /// @brief Result type
+    typedef TRet result_type;
+
+    /// @brief Construct reference to provided functor.
+    /// @pre TFunc invocation must have the same signature as FunctionRef
+    template <
+        typename TFunc,
+        typename = typename std::enable_if<
+            std::is_class<typename std::remove_reference<TFunc>::type>::value &&
+            !std::is_same<typename std::decay<TFunc>::type, FunctionRef>::value
+        >::type>
+    FunctionRef(TFunc&& func)
+        : invoke_(&FunctionRef::template invokeFunctor<typename std::remove_reference<TFunc>::type>)
+    {
+        target_.obj_ = const_cast<void*>(static_cast<const void*>(std::addressof(func)));
+    }
+
+    /// @brief Construct reference to plain function.
+    FunctionRef(FuncPtr func)
+        : invoke_(&FunctionRef::invokeFuncPtr)
+    {
+        GASSERT(func != nullptr);
+        target_.func_ = func;
+    }
+
+    /// @brief Copy constructor
+    FunctionRef(const FunctionRef&) = default;
+
+    /// @brief Copy assignment
+    FunctionRef& operator=(const FunctionRef&) = default;
+
+    /// @brief Function invocation operator.
+    /// @details Invokes referenced functor with provided arguments
+    /// @return What functor returns
+    TRet operator()(TArgs... args) const
+    {
+        return invoke_(target_, std::forward<TArgs>(args)...);
+    }
+
+private:
+    union Target
+    {
+        void* obj_;
+        FuncPtr func_;
+    };
+
+    typedef TRet (*InvokeFunc)(const Target& target, TArgs... args);
+
+    template <typename TFunc>
+    static TRet invokeFunctor(const Target& target, TArgs... args)
+    {
+        return (*reinterpret_cast<TFunc*>(target.obj_))(std::forward<TArgs>(args)...);
+    }
+
+    static TRet invokeFuncPtr(const Target& target, TArgs... args)
+    {
+        return target.func_(std::forward<TArgs>(args)...);
+    }
+
+    Target target_;
+    InvokeFunc invoke_;
+};
+
+/// @}
+
+}  // namespace util
+
+}  // namespace embxx
@@ -0,0 +1,248 @@
+//
+// Copyright 2014 (C). Alex Robenko. All rights reserved.
+//
+
+// This library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file embxx/util/IntrusivePtr.h
+/// This file contains definition of reference counting smart pointer.
+
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "embxx/util/Assert.h"
+
+namespace embxx
+{
+
+namespace util
+{
+
+/// @addtogroup util
+/// @{
+
+/// @brief Reference counting smart pointer.
+/// @details The reference counter is not allocated separately, it is
+///          managed by the control object (TCtrl) that resides together
+///          with the pointed object (usually in the same allocation cell of
+///          the pool, see embxx::util::RefCountedPoolAllocator). Copying
+///          of the pointer just increments the reference counter, the object
+///          is destructed and its memory is released when the last pointer
+///          referencing it is destructed or reset.
+/// @tparam T Type of the pointed object.
+/// @tparam TCtrl Type of the control object. It must provide the
+///         following member functions:
+///         @li @code void addRef(); @endcode
+///         @li @code void release(); @endcode
+///         @li @code std::size_t useCount() const; @endcode
+/// @headerfile embxx/util/IntrusivePtr.h
+template <typename T, typename TCtrl>
+class IntrusivePtr
+{
+    template <typename U, typename TOtherCtrl>
+    friend class IntrusivePtr;
+
+public:
+    /// Type of the pointed object
+    typedef T element_type;
+
+    /// Type of the control object
+    typedef TCtrl CtrlType;
+
+    /// @brief Default constructor, creates empty pointer.
+    IntrusivePtr()
+        : obj_(nullptr),
+          ctrl_(nullptr)
+    {
+    }
+
+    /// @brief Construct empty pointer.
+    IntrusivePtr(std::nullptr_t)
+        : IntrusivePtr()
+    {
+    }
+
+    /// @brief Construct pointer adopting existing reference.
+    /// @details Used by the allocators, the reference counter is not
+    ///          incremented.
+    /// @param obj Pointer to the object.
+    /// @param ctrl Pointer to the control object of the allocation.
+    IntrusivePtr(T* obj, TCtrl* ctrl)
+        : obj_(obj),
+          ctrl_(ctrl)
+    {
+        GASSERT((obj_ == nullptr) == (ctrl_ == nullptr));
+    }
+
+    /// @brief Copy constructor, increments reference counter.
+    IntrusivePtr(const IntrusivePtr& other)
+        : obj_(other.obj_),
+          ctrl_(other.ctrl_)
+    {
+        addRef();
+    }
+
+    /// @brief Copy constructor from pointer to convertible type.
+    template <typename U>
+    IntrusivePtr(const IntrusivePtr<U, TCtrl>& other)
+        : obj_(other.obj_),
+          ctrl_(other.ctrl_)
+    {
+        addRef();
+    }
+
+    /// @brief Move constructor, the other pointer becomes empty.
+    IntrusivePtr(IntrusivePtr&& other)
+        : obj_(other.obj_),
+          ctrl_(other.ctrl_)
+    {
+        other.obj_ = nullptr;
+        other.ctrl_ = nullptr;
+    }
+
+    /// @brief Move constructor from pointer to convertible type.
+    template <typename U>
+    IntrusivePtr(IntrusivePtr<U, TCtrl>&& other)
+        : obj_(other.obj_),
+          ctrl_(other.ctrl_)
+    {
+        other.obj_ = nullptr;
+        other.ctrl_ = nullptr;
+    }
+
+    /// @brief Destructor, decrements reference counter.
+    ~IntrusivePtr()
+    {
+        reset();
+    }
+
+    /// @brief Copy assignment
+    IntrusivePtr& operator=(const IntrusivePtr& other)
+    {
+        IntrusivePtr(other).swap(*this);
+        return *this;
+    }
+
+    /// @brief Copy assignment from pointer to convertible type.
+    template <typename U>
+    IntrusivePtr& operator=(const IntrusivePtr<U, TCtrl>& other)
+    {
+        IntrusivePtr(other).swap(*this);
+        return *this;
+    }
+
+    /// @brief Move assignment
+    IntrusivePtr& operator=(IntrusivePtr&& other)
+    {
+        IntrusivePtr(std::move(other)).swap(*this);
+        return *this;
+    }
+
+    /// @brief Move assignment from pointer to convertible type.
+    template <typename U>
+    IntrusivePtr& operator=(IntrusivePtr<U, TCtrl>&& other)
+    {
+        IntrusivePtr(std::move(other)).swap(*this);
+        return *this;
+    }
+
+    /// @brief Release the reference, the pointer becomes empty.
+    void reset()
+    {
+        auto* ctrl = ctrl_;
+        obj_ = nullptr;
+        ctrl_ = nullptr;
+        if (ctrl != nullptr) {
+            ctrl->release();
+        }
+    }
+
+    /// @brief Swap contents with other pointer.
+    void swap(IntrusivePtr& other)
+    {
+        std::swap(obj_, other.obj_);
+        std::swap(ctrl_, other.ctrl_);
+    }
+
+    /// @brief Get raw pointer to the object.
+    T* get() const
+    {
+        return obj_;
+    }
+
+    /// @brief Get number of pointers referencing the same object.
+    std::size_t useCount() const
+    {
+        if (ctrl_ == nullptr) {
+            return 0U;
+        }
+        return ctrl_->useCount();
+    }
+
+    /// @brief Dereference operator
+    T& operator*() const
+    {
+        GASSERT(obj_ != nullptr);
+        return *obj_;
+    }
+
+    /// @brief Member access operator
+    T* operator->() const
+    {
+        GASSERT(obj_ != nullptr);
+        return obj_;
+    }
+
+    /// @brief Check the pointer is not empty.
+    explicit operator bool() const
+    {
+        return obj_ != nullptr;
+    }
+
+private:
+    void addRef()
+    {
+        if (ctrl_ != nullptr) {
+            ctrl_->addRef();
+        }
+    }
+
+    T* obj_;
+    TCtrl* ctrl_;
+};
+
+/// @}
+
+template <typename T1, typename T2, typename TCtrl>
+bool operator==(
+    const IntrusivePtr<T1, TCtrl>& ptr1,
+    const IntrusivePtr<T2, TCtrl>& ptr2)
+{
+    return ptr1.get() == ptr2.get();
+}
+
+template <typename T1, typename T2, typename TCtrl>
+bool operator!=(
+    const IntrusivePtr<T1, TCtrl>& ptr1,
+    const IntrusivePtr<T2, TCtrl>& ptr2)
+{
+    return !(ptr1 == ptr2);
+}
+
+}  // namespace util
+
+}  // namespace embxx
@@ -0,0 +1,480 @@
+//
+// Copyright 2014 (C). Alex Robenko. All rights reserved.
+//
+
+// This library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file embxx/util/MemoryResource.h
+/// This file contains definition of polymorphic memory resource interface,
+/// its implementations over the static pools and relevant allocator.
+
+#pragma once
+
+#include <cstddef>
+#include <array>
+#include <limits>
+#include <type_traits>
+
+#include "embxx/util/Assert.h"
+#include "embxx/util/StaticPoolAllocator.h"
+
+namespace embxx
+{
+
+namespace util
+{
+
+/// @addtogroup util
+/// @{
+
+/// @brief Polymorphic memory resource interface.
+/// @details Provides the same interface as std::pmr::memory_resource
+///          (available since C++17), so the code that needs to be
+///          independent of the memory allocation strategy can use it
+///          without being templated on allocator type.
+/// @headerfile embxx/util/MemoryResource.h
+class MemoryResource
+{
+public:
+    /// Default alignment, same as alignment of "double", usually 8 bytes.
+    static const std::size_t DefaultAlignment = std::alignment_of<double>::value;
+
+    /// @brief Destructor
+    virtual ~MemoryResource() {}
+
+    /// @brief Allocate memory.
+    /// @param bytes Number of bytes to allocate.
+    /// @param alignment Required alignment.
+    /// @return Pointer to allocated memory, nullptr in case of failure.
+    void* allocate(std::size_t bytes, std::size_t alignment = DefaultAlignment)
+    {
+        return allocateImpl(bytes, alignment);
+    }
+
+    /// @brief Release previously allocated memory.
+    /// @param ptr Pointer returned by previous call to allocate().
+    /// @param bytes Same value as was passed to allocate().
+    /// @param alignment Same value as was passed to allocate().
+    void deallocate(void* ptr, std::size_t bytes, std::size_t alignment = DefaultAlignment)
+    {
+        deallocateImpl(ptr, bytes, alignment);
+    }
+
+    /// @brief Check whether memory allocated by this resource can be
+    ///        released by the other one and vice versa.
+    bool isEqual(const MemoryResource& other) const
+    {
+        return isEqualImpl(other);
+    }
+
+protected:
+    /// @brief Polymorphic allocation functionality to be implemented
+    ///        by the derived class.
+    virtual void* allocateImpl(std::size_t bytes, std::size_t alignment) = 0;
+
+    /// @brief Polymorphic deallocation functionality to be implemented
+    ///        by the derived class.
+    virtual void deallocateImpl(void* ptr, std::size_t bytes, std::size_t alignment) = 0;
+
+    /// @brief Polymorphic comparison functionality, may be overridden
+    ///        by the derived class. By default returns true only when
+    ///        both resources report the same storage.
+    virtual bool isEqualImpl(const MemoryResource& other) const
+    {
+        return storage() == other.storage();
+    }
+
+    /// @brief Identity of the storage the memory is allocated from, may be
+    ///        overridden by the derived class which storage is shared
+    ///        between several objects. By default it is the object itself.
+    virtual const void* storage() const
+    {
+        return this;
+    }
+};
+
+/// @brief Equality comparison of memory resources.
+inline
+bool operator==(const MemoryResource& res1, const MemoryResource& res2)
+{
+    return (&res1 == &res2) || res1.isEqual(res2);
+}
+
+/// @brief Inequality comparison of memory resources.
+inline
+bool operator!=(const MemoryResource& res1, const MemoryResource& res2)
+{
+    return !(res1 == res2);
+}
+
+/// @brief Memory resource over static pool of fixed size cells.
+/// @details Uses embxx::util::StaticPoolAllocator to allocate one or several
+///          contiguous cells. The storage is shared between all the
+///          resources with the same template parameters, so all of them
+///          compare equal.
+/// @tparam TTag Tag type to distinguish between different pools.
+/// @tparam TCellSize Size of single cell.
+/// @tparam TCount Number of cells.
+/// @tparam TAlignment Alignment of the cells.
+/// @headerfile embxx/util/MemoryResource.h
+template <typename TTag,
+          std::size_t TCellSize,
+          std::size_t TCount,
+          std::size_t TAlignment = MemoryResource::DefaultAlignment>
+class StaticPoolResource : public MemoryResource
+{
+    typedef typename std::aligned_storage<TCellSize, TAlignment>::type Cell;
+    typedef StaticPoolAllocator<TTag, Cell, TCount> Allocator;
+
+public:
+    /// Size of single cell
+    static const std::size_t CellSize = sizeof(Cell);
+
+    /// Alignment of the cells
+    static const std::size_t CellAlignment = std::alignment_of<Cell>::value;
+
+protected:
+    virtual void* allocateImpl(std::size_t bytes, std::size_t alignment)
+    {
+        if (CellAlignment < alignment) {
+            return nullptr;
+        }
+
+        return Allocator().allocate(numOfCells(bytes));
+    }
+
+    virtual void deallocateImpl(void* ptr, std::size_t bytes, std::size_t alignment)
+    {
+        static_cast<void>(alignment);
+        GASSERT(alignment <= CellAlignment);
+        Allocator().deallocate(reinterpret_cast<Cell*>(ptr), numOfCells(bytes));
+    }
+
+    virtual const void* storage() const
+    {
+        static const char Storage = 0;
+        return &Storage;
+    }
+
+private:
+    static std::size_t numOfCells(std::size_t bytes)
+    {
+        if (bytes == 0U) {
+            return 1U;
+        }
+        return (bytes + (CellSize - 1)) / CellSize;
+    }
+};
+
+template <typename TTag, std::size_t TCellSize, std::size_t TCount, std::size_t TAlignment>
+const std::size_t StaticPoolResource<TTag, TCellSize, TCount, TAlignment>::CellSize;
+
+template <typename TTag, std::size_t TCellSize, std::size_t TCount, std::size_t TAlignment>
+const std::size_t StaticPoolResource<TTag, TCellSize, TCount, TAlignment>::CellAlignment;
+
+/// @brief Memory resource over embxx::util::MonotonicArena.
+/// @details The deallocation does nothing, the memory is reclaimed
+///          when the arena is reset.
+/// @tparam TArena Type of the arena.
+/// @headerfile embxx/util/MemoryResource.h
+template <typename TArena>
+class MonotonicArenaResource : public MemoryResource
+{
+public:
+    /// @brief Constructor
+    /// @param arena Reference to the arena, must outlive the resource.
+    explicit MonotonicArenaResource(TArena& arena)
+        : arena_(arena)
+    {
+    }
+
+    /// Copy constructor is deleted
+    MonotonicArenaResource(const MonotonicArenaResource&) = delete;
+
+    /// Copy assignment is deleted
+    MonotonicArenaResource& operator=(const MonotonicArenaResource&) = delete;
+
+protected:
+    virtual void* allocateImpl(std::size_t bytes, std::size_t alignment)
+    {
+        return arena_.allocate(bytes, alignment);
+    }
+
+    virtual void deallocateImpl(void* ptr, std::size_t bytes, std::size_t alignment)
+    {
+        static_cast<void>(ptr);
+        static_cast<void>(bytes);
+        static_cast<void>(alignment);
+    }
+
+private:
+    TArena& arena_;
+};
+
+/// @cond DOCUMENT_ASSERT_MANAGER
+namespace details
+{
+
+template <typename TTag, std::size_t TIdx>
+struct PoolOfPoolsResourceClassTag {};
+
+template <typename TTag,
+          std::size_t TMinCellSize,
+          std::size_t TCellsPerClass,
+          std::size_t TAlignment,
+          std::size_t TIdx,
+          std::size_t TRemaining>
+class PoolOfPoolsResourceClasses
+{
+    typedef StaticPoolResource<
+        PoolOfPoolsResourceClassTag<TTag, TIdx>,
+        (TMinCellSize << TIdx),
+        TCellsPerClass,
+        TAlignment> Resource;
+
+    typedef PoolOfPoolsResourceClasses<
+        TTag,
+        TMinCellSize,
+        TCellsPerClass,
+        TAlignment,
+        TIdx + 1,
+        TRemaining - 1> Rest;
+
+public:
+    template <typename TArray>
+    void assign(TArray& resources)
+    {
+        resources[TIdx] = &resource_;
+        rest_.assign(resources);
+    }
+
+private:
+    Resource resource_;
+    Rest rest_;
+};
+
+template <typename TTag,
+          std::size_t TMinCellSize,
+          std::size_t TCellsPerClass,
+          std::size_t TAlignment,
+          std::size_t TIdx>
+class PoolOfPoolsResourceClasses<TTag, TMinCellSize, TCellsPerClass, TAlignment, TIdx, 0>
+{
+public:
+    template <typename TArray>
+    void assign(TArray& resources)
+    {
+        static_cast<void>(resources);
+    }
+};
+
+}  // namespace details
+/// @endcond
+
+/// @brief Memory resource with several size classes.
+/// @details Contains TNumOfClasses static pools, cell size of the first
+///          one is TMinCellSize, cell size of every other one doubles the
+///          previous. The allocation request is forwarded to the pool with
+///          the smallest cells that can hold the requested number of bytes.
+///          Requests that are bigger than the biggest cell size fail.
+///          The pools are shared between all the resources with the same
+///          template parameters, so all of them compare equal.
+/// @tparam TTag Tag type to distinguish between different resources.
+/// @tparam TMinCellSize Cell size of the first size class.
+/// @tparam TNumOfClasses Number of size classes.
+/// @tparam TCellsPerClass Number of cells in every size class.
+/// @tparam TAlignment Alignment of the cells.
+/// @headerfile embxx/util/MemoryResource.h
+template <typename TTag,
+          std::size_t TMinCellSize,
+          std::size_t TNumOfClasses,
+          std::size_t TCellsPerClass,
+          std::size_t TAlignment = MemoryResource::DefaultAlignment>
+class PoolOfPoolsResource : public MemoryResource
+{
+    static_assert(0U < TMinCellSize, "Minimal cell size must be greater than 0");
+    static_assert(0U < TNumOfClasses, "Number of size classes must be greater than 0");
+
+    typedef details::PoolOfPoolsResourceClasses<
+        TTag,
+        TMinCellSize,
+        TCellsPerClass,
+        TAlignment,
+        0,
+        TNumOfClasses> Classes;
+
+public:
+    /// Size of the biggest allocation
+    static const std::size_t MaxCellSize = TMinCellSize << (TNumOfClasses - 1);
+
+    /// Constructor
+    PoolOfPoolsResource()
+    {
+        classes_.assign(resources_);
+    }
+
+    /// Copy constructor is deleted
+    PoolOfPoolsResource(const PoolOfPoolsResource&) = delete;
+
+    /// Copy assignment is deleted
+    PoolOfPoolsResource& operator=(const PoolOfPoolsResource&) = delete;
+
+protected:
+    virtual void* allocateImpl(std::size_t bytes, std::size_t alignment)
+    {
+        auto idx = classIdx(bytes);
+        if (TNumOfClasses <= idx) {
+            return nullptr;
+        }
+        return resources_[idx]->allocate(bytes, alignment);
+    }
+
+    virtual void deallocateImpl(void* ptr, std::size_t bytes, std::size_t alignment)
+    {
+        auto idx = classIdx(bytes);
+        GASSERT(idx < TNumOfClasses);
+        resources_[idx]->deallocate(ptr, bytes, alignment);
+    }
+
+    virtual const void* storage() const
+    {
+        static const char Storage = 0;
+        return &Storage;
+    }
+
+private:
+    static std::size_t classIdx(std::size_t bytes)
+    {
+        std::size_t idx = 0U;
+        auto cellSize = TMinCellSize;
+        while ((idx < TNumOfClasses) && (cellSize < bytes)) {
+            ++idx;
+            cellSize <<= 1;
+        }
+        return idx;
+    }
+
+    Classes classes_;
+    std::array<MemoryResource*, TNumOfClasses> resources_;
+};
+
+template <typename TTag,
+          std::size_t TMinCellSize,
+          std::size_t TNumOfClasses,
+          std::size_t TCellsPerClass,
+          std::size_t TAlignment>
+const std::size_t
+PoolOfPoolsResource<TTag, TMinCellSize, TNumOfClasses, TCellsPerClass, TAlignment>::MaxCellSize;
+
+/// @brief Standard compliant allocator that uses provided memory resource.
+/// @details Can be used with std containers to use memory provided by any
+///          embxx::util::MemoryResource.
+/// @tparam T Type of allocated object.
+/// @headerfile embxx/util/MemoryResource.h
+template <typename T>
+class PolymorphicAllocator
+{
+    template <typename U>
+    friend class PolymorphicAllocator;
+
+public:
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    template <typename U>
+    struct rebind
+    {
+        typedef PolymorphicAllocator<U> other;
+    };
+
+    /// @brief Constructor
+    /// @param resource Memory resource, must outlive the allocator.
+    PolymorphicAllocator(MemoryResource& resource)
+        : resource_(&resource)
+    {
+    }
+
+    /// @brief Converting constructor
+    template <typename U>
+    PolymorphicAllocator(const PolymorphicAllocator<U>& other)
+        : resource_(other.resource_)
+    {
+    }
+
+    PolymorphicAllocator(const PolymorphicAllocator&) = default;
+    ~PolymorphicAllocator() = default;
+    PolymorphicAllocator& operator=(const PolymorphicAllocator&) = default;
+
+    /// @brief Allocate memory for num objects.
+    /// @return Pointer to allocated memory, nullptr in case of failure.
+    pointer allocate(size_type num)
+    {
+        if (max_size() < num) {
+            return nullptr;
+        }
+
+        return reinterpret_cast<pointer>(
+            resource_->allocate(num * sizeof(T), std::alignment_of<T>::value));
+    }
+
+    /// @brief Release memory previously allocated with allocate().
+    void deallocate(pointer ptr, size_type num)
+    {
+        GASSERT(num <= max_size());
+        resource_->deallocate(ptr, num * sizeof(T), std::alignment_of<T>::value);
+    }
+
+    /// @brief Maximal number of objects which size in bytes doesn't
+    ///        overflow size_type.
+    constexpr size_type max_size() const
+    {
+        return std::numeric_limits<size_type>::max() / sizeof(T);
+    }
+
+    /// @brief Get access to memory resource.
+    MemoryResource& resource() const
+    {
+        return *resource_;
+    }
+
+private:
+    MemoryResource* resource_;
+};
+
+/// @}
+
+template <typename T1, typename T2>
+bool operator==(
+    const PolymorphicAllocator<T1>& a1,
+    const PolymorphicAllocator<T2>& a2)
+{
+    return a1.resource() == a2.resource();
+}
+
+template <typename T1, typename T2>
+bool operator!=(
+    const PolymorphicAllocator<T1>& a1,
+    const PolymorphicAllocator<T2>& a2)
+{
+    return !(a1 == a2);
+}
+
+}  // namespace util
+
+}  // namespace embxx
@@ -0,0 +1,344 @@
+//
+// Copyright 2014 (C). Alex Robenko. All rights reserved.
+//
+
+// This library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file embxx/util/MonotonicArena.h
+/// This file contains definition of monotonic (bump pointer) arena and
+/// relevant allocators.
+
+#pragma once
+
+#include <new>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "embxx/util/Assert.h"
+
+namespace embxx
+{
+
+namespace util
+{
+
+/// @addtogroup util
+/// @{
+
+/// @brief Monotonic (bump pointer) memory arena.
+/// @details Allocates the memory sequentially from the internal storage area.
+///          The single allocated blocks are never released, all the memory
+///          is reclaimed at once by reset(), which takes constant time.
+///          It is suitable for allocation of the objects required during
+///          processing of single frame/message, which are all released
+///          when processing is complete.
+///
+///          The arena can also be used as an object allocation policy
+///          (for example as TAllocator parameter of
+///          embxx::comms::protocol::MsgIdLayer), it provides
+///          alloc() member function similar to other allocators in
+///          "embxx/util/Allocators.h". The std containers may use its
+///          memory via embxx::util::MonotonicArenaAllocator.
+/// @tparam TSize Size of the arena in bytes.
+/// @tparam TAlignment Alignment of the storage area. By default the alignment
+///         will be the same as alignment of "double", usually 8 bytes.
+/// @headerfile embxx/util/MonotonicArena.h
+template <std::size_t TSize,
+          std::size_t TAlignment = std::alignment_of<double>::value>
+class MonotonicArena
+{
+public:
+
+    /// @cond DOCUMENT_ASSERT_MANAGER
+
+    /// @brief Deleter class
+    /// @details Calls destructor of the object, the memory is not
+    ///          released until arena is reset.
+    template <typename T>
+    class Deleter
+    {
+        template<typename U>
+        friend class Deleter;
+
+    public:
+        /// Constructor used by MonotonicArena to create std::unique_ptr
+        Deleter(std::size_t* liveCount = nullptr)
+            : liveCount_(liveCount)
+        {
+        }
+
+        /// Copy constructor is deleted
+        Deleter(const Deleter& other) = delete;
+
+        template <typename U>
+        Deleter(Deleter<U>&& other)
+            : liveCount_(other.liveCount_)
+        {
+            static_assert(std::is_base_of<T, U>::value ||
+                          std::is_base_of<U, T>::value ||
+                          std::is_convertible<U, T>::value ||
+                          std::is_convertible<T, U>::value ,
+                "To make Deleter convertible, their template parameters "
+                "must be convertible.");
+
+            other.liveCount_ = nullptr;
+        }
+
+        ~Deleter()
+        {
+            GASSERT(liveCount_ == nullptr);
+        }
+
+        /// Copy assignment is deleted
+        Deleter& operator=(const Deleter& other) = delete;
+
+        template <typename U>
+        Deleter& operator=(Deleter<U>&& other)
+        {
+            static_assert(std::is_base_of<T, U>::value ||
+                          std::is_base_of<U, T>::value ||
+                          std::is_convertible<U, T>::value ||
+                          std::is_convertible<T, U>::value ,
+                "To make Deleter convertible, their template parameters "
+                "must be convertible.");
+
+            if (reinterpret_cast<void*>(this) == reinterpret_cast<const void*>(&other)) {
+                return *this;
+            }
+
+            GASSERT(liveCount_ == nullptr);
+            liveCount_ = other.liveCount_;
+            other.liveCount_ = nullptr;
+            return *this;
+        }
+
+        /// @brief Deletion operator
+        /// @details Executes destructor of the deleted object
+        void operator()(T* obj) {
+            GASSERT(liveCount_ != nullptr);
+            GASSERT(0U < *liveCount_);
+            obj->~T();
+            --(*liveCount_);
+            liveCount_ = nullptr;
+        }
+
+    private:
+        std::size_t* liveCount_;
+    };
+    /// @endcond
+
+    /// Constructor
+    MonotonicArena()
+        : offset_(0U),
+          liveCount_(0U)
+    {
+    }
+
+    /// Copy constructor is deleted
+    MonotonicArena(const MonotonicArena&) = delete;
+
+    /// Destructor
+    ~MonotonicArena()
+    {
+        GASSERT(liveCount_ == 0U);
+    }
+
+    /// Copy assignment is deleted
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    /// @brief Allocate raw memory.
+    /// @param size Number of bytes to allocate.
+    /// @param alignment Required alignment, must be power of 2.
+    /// @return Pointer to allocated memory, nullptr if there is not
+    ///         enough space left in the arena.
+    void* allocate(std::size_t size, std::size_t alignment)
+    {
+        GASSERT((alignment != 0U) && ((alignment & (alignment - 1)) == 0U));
+        auto* begin = reinterpret_cast<std::uint8_t*>(&place_);
+        auto addr = reinterpret_cast<std::uintptr_t>(begin + offset_);
+        auto padding =
+            static_cast<std::size_t>((alignment - (addr & (alignment - 1))) & (alignment - 1));
+
+        if ((TSize - offset_) < padding) {
+            return nullptr;
+        }
+
+        auto start = offset_ + padding;
+        if ((TSize - start) < size) {
+            return nullptr;
+        }
+
+        offset_ = start + size;
+        return begin + start;
+    }
+
+    /// @brief Allocation function
+    /// @details Uses in place object construction in the arena memory.
+    /// @tparam TObj Type of object to by constructed
+    /// @tparam TArgs Types of the parameters required to create an object.
+    /// @return std::unique_ptr to constructed object with custom deleter that
+    ///         calls the destructor of the object. The pointer is empty if
+    ///         there is not enough space left in the arena.
+    template <typename TObj, typename... TArgs>
+    std::unique_ptr<TObj, Deleter<TObj> > alloc(TArgs&&... args)
+    {
+        typedef Deleter<TObj> Del;
+        std::unique_ptr<TObj, Del> ptr(nullptr, Del());
+        auto* place = allocate(sizeof(TObj), std::alignment_of<TObj>::value);
+        if (place != nullptr) {
+            ptr.reset(new (place) TObj(std::forward<TArgs>(args)...));
+            ++liveCount_;
+            ptr.get_deleter() = Del(&liveCount_);
+        }
+        return ptr;
+    }
+
+    /// @brief Release all the allocated memory.
+    /// @pre All the objects allocated using alloc() must be destructed.
+    void reset()
+    {
+        GASSERT(liveCount_ == 0U);
+        offset_ = 0U;
+    }
+
+    /// @brief Get number of allocated bytes (including alignment padding).
+    std::size_t used() const
+    {
+        return offset_;
+    }
+
+    /// @brief Get number of bytes left.
+    std::size_t available() const
+    {
+        return TSize - offset_;
+    }
+
+    /// @brief Get total size of the arena.
+    constexpr std::size_t capacity() const
+    {
+        return TSize;
+    }
+
+private:
+    typename std::aligned_storage<TSize, TAlignment>::type place_;
+    std::size_t offset_;
+    std::size_t liveCount_;
+};
+
+/// @brief Standard compliant allocator that uses memory of
+///        embxx::util::MonotonicArena.
+/// @details Deallocation is a no-op, the memory is reclaimed when the
+///          arena is reset. Can be used with std containers.
+/// @tparam T Type of allocated object.
+/// @tparam TArena Type of the arena.
+/// @headerfile embxx/util/MonotonicArena.h
+template <typename T, typename TArena>
+class MonotonicArenaAllocator
+{
+    template <typename U, typename TOtherArena>
+    friend class MonotonicArenaAllocator;
+
+public:
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    template <typename U>
+    struct rebind
+    {
+        typedef MonotonicArenaAllocator<U, TArena> other;
+    };
+
+    /// @brief Constructor
+    /// @param arena Reference to the arena, must outlive the allocator.
+    explicit MonotonicArenaAllocator(TArena& arena)
+        : arena_(&arena)
+    {
+    }
+
+    /// @brief Converting constructor
+    template <typename U>
+    MonotonicArenaAllocator(const MonotonicArenaAllocator<U, TArena>& other)
+        : arena_(other.arena_)
+    {
+    }
+
+    MonotonicArenaAllocator(const MonotonicArenaAllocator&) = default;
+    ~MonotonicArenaAllocator() = default;
+    MonotonicArenaAllocator& operator=(const MonotonicArenaAllocator&) = default;
+
+    /// @brief Allocate memory for num objects.
+    /// @return Pointer to allocated memory, nullptr if there is not
+    ///         enough space left in the arena.
+    pointer allocate(size_type num)
+    {
+        if (max_size() < num) {
+            return nullptr;
+        }
+
+        return reinterpret_cast<pointer>(
+            arena_->allocate(num * sizeof(T), std::alignment_of<T>::value));
+    }
+
+    /// @brief Deallocation does nothing, the memory is reclaimed by
+    ///        reset() of the arena.
+    void deallocate(pointer ptr, size_type num)
+    {
+        static_cast<void>(ptr);
+        static_cast<void>(num);
+    }
+
+    size_type max_size() const
+    {
+        return arena_->capacity() / sizeof(T);
+    }
+
+    /// @brief Get access to the arena.
+    TArena& arena() const
+    {
+        return *arena_;
+    }
+
+private:
+    TArena* arena_;
+};
+
+/// @}
+
+template <typename T1, typename T2, typename TArena>
+bool operator==(
+    const MonotonicArenaAllocator<T1, TArena>& a1,
+    const MonotonicArenaAllocator<T2, TArena>& a2)
+{
+    return &a1.arena() == &a2.arena();
+}
+
+template <typename T1, typename T2, typename TArena>
+bool operator!=(
+    const MonotonicArenaAllocator<T1, TArena>& a1,
+    const MonotonicArenaAllocator<T2, TArena>& a2)
+{
+    return !(a1 == a2);
+}
+
+}  // namespace util
+
+}  // namespace embxx
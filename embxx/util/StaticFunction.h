@@ -20,6 +20,8 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstring>
 #include <type_traits>
 #include <new>
 #include <functional>
@@ -32,6 +34,283 @@ namespace embxx
 namespace util
 {
 
+/// @cond DOCUMENT_STATIC_FUNCTION_INVOKER
+namespace details
+{
+
+template <typename T>
+struct StaticFunctionIsTriviallyCopyable
+{
+#if defined(__GNUC__) && !defined(__clang__) && (__GNUC__ < 5)
+    static const bool Value = __has_trivial_copy(T) && __has_trivial_destructor(T);
+#else
+    static const bool Value = std::is_trivially_copyable<T>::value;
+#endif
+};
+
+// Incomplete specialisation is used to report both sizes in the compilation
+// error when the functor doesn't fit.
+template <std::size_t TCapacity, std::size_t TRequired, bool TFits = (TRequired <= TCapacity)>
+struct StaticFunctionSizeCheck
+{
+    static const bool Value = true;
+};
+
+template <std::size_t TCapacity, std::size_t TRequired>
+struct StaticFunctionSizeCheck<TCapacity, TRequired, false>;
+
+template <std::size_t TCapacity, std::size_t TRequired>
+struct StaticFunctionSizeReport
+{
+#ifdef EMBXX_STATIC_FUNCTION_SIZE_REPORT
+    __attribute__((deprecated("StaticFunction size report: see TCapacity and TRequired")))
+#endif
+    static void report() {}
+};
+
+// The report is issued as deprecation warning, which must stay a warning
+// even when compiling with -Werror.
+template <std::size_t TCapacity, std::size_t TRequired>
+void staticFunctionSizeReport()
+{
+#ifdef EMBXX_STATIC_FUNCTION_SIZE_REPORT
+#pragma GCC diagnostic push
+#pragma GCC diagnostic warning "-Wdeprecated-declarations"
+#endif
+    StaticFunctionSizeReport<TCapacity, TRequired>::report();
+#ifdef EMBXX_STATIC_FUNCTION_SIZE_REPORT
+#pragma GCC diagnostic pop
+#endif
+}
+
+// Storage area together with invocation and manager functions, common to
+// StaticFunction and StaticUniqueFunction. The stored functor is copied
+// only when TCopyable is true, so move-only functors may be stored
+// otherwise.
+template <std::size_t TSize, bool TCopyable, typename TRet, typename... TArgs>
+class StaticFunctionBase
+{
+protected:
+    StaticFunctionBase();
+    StaticFunctionBase(const StaticFunctionBase&) = delete;
+    StaticFunctionBase& operator=(const StaticFunctionBase&) = delete;
+
+    bool valid() const;
+    TRet invokeHandler(TArgs... args) const;
+    void destroyHandler();
+    void copyHandlerFrom(const StaticFunctionBase& other);
+    void moveHandlerFrom(StaticFunctionBase& other);
+    template <typename TFunc>
+    void assignHandler(TFunc&& func);
+
+private:
+    enum class ManageOp
+    {
+        Copy,
+        Move,
+        Destroy
+    };
+
+    typedef TRet (*InvokeFunc)(void* place, TArgs... args);
+    typedef void (*ManageFunc)(ManageOp op, void* from, void* to);
+
+    template <typename TBound>
+    struct BoundOps
+    {
+        static TRet invoke(void* place, TArgs... args);
+        static void manage(ManageOp op, void* from, void* to);
+        static void manageTrivial(ManageOp op, void* from, void* to);
+        static void copy(void* from, void* to, std::true_type);
+        static void copy(void* from, void* to, std::false_type);
+    };
+
+    typedef typename
+        std::aligned_storage<
+            TSize,
+            std::alignment_of<double>::value
+        >::type StorageType;
+
+    StorageType handler_;
+    InvokeFunc invoke_;
+    ManageFunc manage_;
+};
+
+template <std::size_t TSize, bool TCopyable, typename TRet, typename... TArgs>
+StaticFunctionBase<TSize, TCopyable, TRet, TArgs...>::StaticFunctionBase()
+    : invoke_(nullptr),
+      manage_(nullptr)
+{
+}
+
+template <std::size_t TSize, bool TCopyable, typename TRet, typename... TArgs>
+bool StaticFunctionBase<TSize, TCopyable, TRet, TArgs...>::valid() const
+{
+    return invoke_ != nullptr;
+}
+
+template <std::size_t TSize, bool TCopyable, typename TRet, typename... TArgs>
+TRet StaticFunctionBase<TSize, TCopyable, TRet, TArgs...>::invokeHandler(
+    TArgs... args) const
+{
+    GASSERT(invoke_ != nullptr);
+    auto* place = const_cast<StorageType*>(&handler_);
+    return invoke_(place, std::forward<TArgs>(args)...);
+}
+
+template <std::size_t TSize, bool TCopyable, typename TRet, typename... TArgs>
+void StaticFunctionBase<TSize, TCopyable, TRet, TArgs...>::destroyHandler()
+{
+    if (invoke_ != nullptr) {
+        manage_(ManageOp::Destroy, &handler_, nullptr);
+    }
+    invoke_ = nullptr;
+    manage_ = nullptr;
+}
+
+template <std::size_t TSize, bool TCopyable, typename TRet, typename... TArgs>
+void StaticFunctionBase<TSize, TCopyable, TRet, TArgs...>::copyHandlerFrom(
+    const StaticFunctionBase& other)
+{
+    static_assert(TCopyable, "The function is not copyable");
+
+    GASSERT(invoke_ == nullptr);
+    if (other.invoke_ == nullptr) {
+        return;
+    }
+
+    auto* from = const_cast<StorageType*>(&other.handler_);
+    other.manage_(ManageOp::Copy, from, &handler_);
+
+    invoke_ = other.invoke_;
+    manage_ = other.manage_;
+}
+
+template <std::size_t TSize, bool TCopyable, typename TRet, typename... TArgs>
+void StaticFunctionBase<TSize, TCopyable, TRet, TArgs...>::moveHandlerFrom(
+    StaticFunctionBase& other)
+{
+    GASSERT(invoke_ == nullptr);
+    if (other.invoke_ == nullptr) {
+        return;
+    }
+
+    other.manage_(ManageOp::Move, &other.handler_, &handler_);
+
+    invoke_ = other.invoke_;
+    manage_ = other.manage_;
+    other.invoke_ = nullptr;
+    other.manage_ = nullptr;
+}
+
+template <std::size_t TSize, bool TCopyable, typename TRet, typename... TArgs>
+template <typename TFunc>
+void StaticFunctionBase<TSize, TCopyable, TRet, TArgs...>::assignHandler(
+    TFunc&& func)
+{
+    typedef typename std::decay<TFunc>::type DecayedFuncType;
+
+    static_assert(
+        StaticFunctionSizeCheck<TSize, sizeof(DecayedFuncType)>::Value,
+        "Increase the TSize template argument of the function");
+
+    static_assert(
+        std::alignment_of<DecayedFuncType>::value <= std::alignment_of<StorageType>::value,
+        "Alignment requirement of the functor is too big");
+
+    staticFunctionSizeReport<TSize, sizeof(DecayedFuncType)>();
+
+    GASSERT(invoke_ == nullptr);
+    auto handlerPtr = new (&handler_) DecayedFuncType(std::forward<TFunc>(func));
+    static_cast<void>(handlerPtr);
+    invoke_ = &BoundOps<DecayedFuncType>::invoke;
+    if (StaticFunctionIsTriviallyCopyable<DecayedFuncType>::Value) {
+        manage_ = &BoundOps<DecayedFuncType>::manageTrivial;
+    }
+    else {
+        manage_ = &BoundOps<DecayedFuncType>::manage;
+    }
+}
+
+template <std::size_t TSize, bool TCopyable, typename TRet, typename... TArgs>
+template <typename TBound>
+TRet StaticFunctionBase<TSize, TCopyable, TRet, TArgs...>::BoundOps<TBound>::invoke(
+    void* place,
+    TArgs... args)
+{
+    return (*reinterpret_cast<TBound*>(place))(std::forward<TArgs>(args)...);
+}
+
+template <std::size_t TSize, bool TCopyable, typename TRet, typename... TArgs>
+template <typename TBound>
+void StaticFunctionBase<TSize, TCopyable, TRet, TArgs...>::BoundOps<TBound>::manage(
+    ManageOp op,
+    void* from,
+    void* to)
+{
+    auto* fromFunc = reinterpret_cast<TBound*>(from);
+    switch (op) {
+    case ManageOp::Copy:
+        copy(from, to, std::integral_constant<bool, TCopyable>());
+        break;
+
+    case ManageOp::Move:
+        {
+            auto toFunc = new (to) TBound(std::move(*fromFunc));
+            static_cast<void>(toFunc);
+            fromFunc->~TBound();
+        }
+        break;
+
+    case ManageOp::Destroy:
+        fromFunc->~TBound();
+        break;
+
+    default:
+        GASSERT(!"Unknown operation");
+        break;
+    }
+}
+
+// Copies and moves only the bytes of the functor, the rest of the storage
+// area is never initialised.
+template <std::size_t TSize, bool TCopyable, typename TRet, typename... TArgs>
+template <typename TBound>
+void StaticFunctionBase<TSize, TCopyable, TRet, TArgs...>::BoundOps<TBound>::manageTrivial(
+    ManageOp op,
+    void* from,
+    void* to)
+{
+    if (op != ManageOp::Destroy) {
+        std::memcpy(to, from, sizeof(TBound));
+    }
+}
+
+template <std::size_t TSize, bool TCopyable, typename TRet, typename... TArgs>
+template <typename TBound>
+void StaticFunctionBase<TSize, TCopyable, TRet, TArgs...>::BoundOps<TBound>::copy(
+    void* from,
+    void* to,
+    std::true_type)
+{
+    auto toFunc = new (to) TBound(*reinterpret_cast<const TBound*>(from));
+    static_cast<void>(toFunc);
+}
+
+template <std::size_t TSize, bool TCopyable, typename TRet, typename... TArgs>
+template <typename TBound>
+void StaticFunctionBase<TSize, TCopyable, TRet, TArgs...>::BoundOps<TBound>::copy(
+    void* from,
+    void* to,
+    std::false_type)
+{
+    static_cast<void>(from);
+    static_cast<void>(to);
+    GASSERT(!"The function is not copyable");
+}
+
+}  // namespace details
+/// @endcond
+
 /// @addtogroup util
 /// @{
 
@@ -46,10 +325,27 @@ class StaticFunction;
 ///          use dynamic memory allocation, hence it must receive amount of space
 ///          required to store provided functor object.
 ///
+///          Besides the storage area the object contains only two pointers:
+///          one to the invocation function and one to the manager function
+///          that copies, moves and destroys the stored functor. When the
+///          stored functor is trivially copyable (plain function pointer,
+///          lambda capturing only references or scalars) the manager just
+///          copies sizeof(functor) bytes with memcpy() and does nothing on
+///          destruction.
+///
+///          When the functor doesn't fit into the storage area the
+///          compilation fails with error mentioning
+///          @b details::StaticFunctionSizeCheck<Capacity, Required>.
+///          Defining @b EMBXX_STATIC_FUNCTION_SIZE_REPORT symbol when compiling
+///          with GCC or Clang causes a warning to be issued for every stored
+///          functor type reporting its size together with the capacity of
+///          the StaticFunction, which allows tuning of the TSize parameter.
+///          The report stays a warning even when compiling with -Werror.
+///
 ///          This is template specialisation of the following class definition
 ///          @code
 ///          // TSignature is a combination of return value an arguments: TRet(TArgs...)
-///          template <typename TSignature, std::size_t TSize = 16>
+///          template <typename TSignature, std::size_t TSize = sizeof(void*) * 3>
 ///          class StaticFunction;
 ///          @endcode
 /// @tparam TSize Size of the space required to store provided functor.
@@ -57,14 +353,28 @@ class StaticFunction;
 /// @tparam TArgs Argument types
 /// @headerfile embxx/util/StaticFunction.h
 template <std::size_t TSize, typename TRet, typename... TArgs>
-class StaticFunction<TRet (TArgs...), TSize>
+class StaticFunction<TRet (TArgs...), TSize> :
+    private details::StaticFunctionBase<TSize, true, TRet, TArgs...>
 {
+    typedef details::StaticFunctionBase<TSize, true, TRet, TArgs...> Base;
+
 public:
     /// @brief Result type
     typedef TRet result_type;
 
     static const std::size_t Size = TSize;
 
+    /// @brief Check whether the functor of provided type may be stored.
+    template <typename TFunc>
+    struct CanStore
+    {
+        /// @brief true if and only if the functor fits into the storage area
+        static const bool Value =
+            (sizeof(typename std::decay<TFunc>::type) <= TSize) &&
+            (std::alignment_of<typename std::decay<TFunc>::type>::value <=
+                std::alignment_of<double>::value);
+    };
+
     /// @brief Default constructor
     StaticFunction();
 
@@ -77,6 +387,9 @@ public:
     /// @brief Copy constructor
     StaticFunction(const StaticFunction& other);
 
+    /// @brief Non-const param copy constructor
+    StaticFunction(StaticFunction& other);
+
     /// @brief Move constructor
     StaticFunction(StaticFunction&& other);
 
@@ -131,52 +444,8 @@ public:
     TRet operator()(TArgs... args);
 
 private:
-
-    /// @cond DOCUMENT_STATIC_FUNCTION_INVOKER
-    class Invoker
-    {
-    public:
-        virtual ~Invoker();
-        virtual TRet exec(TArgs... args) const = 0;
-        virtual TRet exec(TArgs... args) = 0;
-        virtual void copyTo(void* other) const = 0;
-        virtual void moveTo(void* other) = 0;
-    private:
-    };
-
-    template <typename TBound>
-    class InvokerBound : public Invoker
-    {
-    public:
-        template <typename TFunc>
-        InvokerBound(TFunc&& func);
-        InvokerBound(const InvokerBound&) = default;
-        InvokerBound(InvokerBound&&) = default;
-        virtual ~InvokerBound();
-        virtual TRet exec(TArgs... args) const;
-        virtual TRet exec(TArgs... args);
-        virtual void copyTo(void* other) const;
-        virtual void moveTo(void* other);
-    private:
-        TBound func_;
-    };
-    /// @endcond
-
-    static const std::size_t StorageAreaSize = TSize + sizeof(Invoker);
-    typedef typename
-        std::aligned_storage<
-            StorageAreaSize,
-            std::alignment_of<Invoker>::value
-        >::type StorageType;
-
-    Invoker* getInvoker();
-    const Invoker* getInvoker() const;
-    void destroyHandler();
     template <typename TFunc>
     void assignHandler(TFunc&& func);
-
-    StorageType handler_;
-    bool valid_;
 };
 
 /// @}
@@ -184,14 +453,12 @@ private:
 // Implementation
 template <std::size_t TSize, typename TRet, typename... TArgs>
 StaticFunction<TRet (TArgs...), TSize>::StaticFunction()
-    : valid_(false)
 {
 }
 
 template <std::size_t TSize, typename TRet, typename... TArgs>
 template <typename TFunc>
 StaticFunction<TRet (TArgs...), TSize>::StaticFunction(TFunc&& func)
-    : valid_(true)
 {
     assignHandler(std::forward<TFunc>(func));
 }
@@ -199,30 +466,30 @@ StaticFunction<TRet (TArgs...), TSize>::StaticFunction(TFunc&& func)
 template <std::size_t TSize, typename TRet, typename... TArgs>
 StaticFunction<TRet (TArgs...), TSize>::StaticFunction(
     const StaticFunction& other)
-    : valid_(other.valid_)
+    : Base()
+{
+    Base::copyHandlerFrom(other);
+}
+
+template <std::size_t TSize, typename TRet, typename... TArgs>
+StaticFunction<TRet (TArgs...), TSize>::StaticFunction(
+    StaticFunction& other)
+    : StaticFunction(static_cast<const StaticFunction&>(other))
 {
-    if (valid_) {
-        auto otherInvoker = other.getInvoker();
-        otherInvoker->copyTo(&handler_);
-    }
 }
 
 template <std::size_t TSize, typename TRet, typename... TArgs>
 StaticFunction<TRet (TArgs...), TSize>::StaticFunction(
     StaticFunction&& other)
-    : valid_(other.valid_)
+    : Base()
 {
-    if (valid_) {
-        auto otherInvoker = other.getInvoker();
-        otherInvoker->moveTo(&handler_);
-        other = nullptr;
-    }
+    Base::moveHandlerFrom(other);
 }
 
 template <std::size_t TSize, typename TRet, typename... TArgs>
 StaticFunction<TRet (TArgs...), TSize>::~StaticFunction()
 {
-    destroyHandler();
+    Base::destroyHandler();
 }
 
 template <std::size_t TSize, typename TRet, typename... TArgs>
@@ -233,13 +500,8 @@ StaticFunction<TRet (TArgs...), TSize>::operator=(const StaticFunction& other)
         return *this;
     }
 
-    destroyHandler();
-    valid_ = other.valid_;
-    if (valid_) {
-        auto otherInvoker = other.getInvoker();
-        GASSERT(otherInvoker != nullptr);
-        otherInvoker->copyTo(&handler_);
-    }
+    Base::destroyHandler();
+    Base::copyHandlerFrom(other);
     return *this;
 }
 
@@ -258,14 +520,8 @@ StaticFunction<TRet (TArgs...), TSize>::operator=(StaticFunction&& other)
         return *this;
     }
 
-    destroyHandler();
-    valid_ = other.valid_;
-    if (valid_) {
-        auto otherInvoker = other.getInvoker();
-        GASSERT(otherInvoker != nullptr);
-        otherInvoker->moveTo(&handler_);
-        other = nullptr;
-    }
+    Base::destroyHandler();
+    Base::moveHandlerFrom(other);
     return *this;
 }
 
@@ -273,8 +529,7 @@ template <std::size_t TSize, typename TRet, typename... TArgs>
 StaticFunction<TRet (TArgs...), TSize>&
 StaticFunction<TRet (TArgs...), TSize>::operator=(std::nullptr_t)
 {
-    destroyHandler();
-    valid_ = false;
+    Base::destroyHandler();
     return *this;
 }
 
@@ -283,9 +538,8 @@ template <typename TFunc>
 StaticFunction<TRet (TArgs...), TSize>&
 StaticFunction<TRet (TArgs...), TSize>::operator=(TFunc&& func)
 {
-    destroyHandler();
+    Base::destroyHandler();
     assignHandler(std::forward<TFunc>(func));
-    valid_ = true;
     return *this;
 }
 
@@ -295,119 +549,35 @@ StaticFunction<TRet (TArgs...), TSize>&
 StaticFunction<TRet (TArgs...), TSize>::operator=(
     std::reference_wrapper<TFunc> func)
 {
-    destroyHandler();
+    Base::destroyHandler();
     assignHandler(std::forward<TFunc>(func));
-    valid_ = true;
     return *this;
 }
 
 template <std::size_t TSize, typename TRet, typename... TArgs>
 StaticFunction<TRet (TArgs...), TSize>::operator bool() const
 {
-    return valid_;
+    return Base::valid();
 }
 
 template <std::size_t TSize, typename TRet, typename... TArgs>
 bool StaticFunction<TRet (TArgs...), TSize>::operator!() const
 {
-    return !valid_;
+    return !Base::valid();
 }
 
 template <std::size_t TSize, typename TRet, typename... TArgs>
 TRet StaticFunction<TRet (TArgs...), TSize>::operator()(
     TArgs... args) const
 {
-    GASSERT(valid_);
-    auto invoker = getInvoker();
-    return invoker->exec(std::forward<TArgs>(args)...);
+    return Base::invokeHandler(std::forward<TArgs>(args)...);
 }
 
 template <std::size_t TSize, typename TRet, typename... TArgs>
 TRet StaticFunction<TRet (TArgs...), TSize>::operator()(
     TArgs... args)
 {
-    GASSERT(valid_);
-    auto invoker = getInvoker();
-    return invoker->exec(std::forward<TArgs>(args)...);
-}
-
-/// @cond DOCUMENT_STATIC_FUNCTION_INVOKER
-template <std::size_t TSize, typename TRet, typename... TArgs>
-StaticFunction<TRet (TArgs...), TSize>::Invoker::~Invoker()
-{
-}
-
-template <std::size_t TSize, typename TRet, typename... TArgs>
-template <typename TBound>
-template <typename TFunc>
-StaticFunction<TRet (TArgs...), TSize>::InvokerBound<TBound>::InvokerBound(
-    TFunc&& func)
-    : func_(std::forward<TFunc>(func))
-{
-}
-
-template <std::size_t TSize, typename TRet, typename... TArgs>
-template <typename TBound>
-StaticFunction<TRet (TArgs...), TSize>::InvokerBound<TBound>::~InvokerBound()
-{
-}
-
-template <std::size_t TSize, typename TRet, typename... TArgs>
-template <typename TBound>
-TRet StaticFunction<TRet (TArgs...), TSize>::InvokerBound<TBound>::exec(
-    TArgs... args) const
-{
-    return func_(std::forward<TArgs>(args)...);
-}
-
-template <std::size_t TSize, typename TRet, typename... TArgs>
-template <typename TBound>
-TRet StaticFunction<TRet (TArgs...), TSize>::InvokerBound<TBound>::exec(
-    TArgs... args)
-{
-    return func_(std::forward<TArgs>(args)...);
-}
-
-template <std::size_t TSize, typename TRet, typename... TArgs>
-template <typename TBound>
-void StaticFunction<TRet (TArgs...), TSize>::InvokerBound<TBound>::copyTo(
-    void* place) const
-{
-    auto otherInvoker = new (place) InvokerBound(*this);
-    static_cast<void>(otherInvoker);
-}
-
-template <std::size_t TSize, typename TRet, typename... TArgs>
-template <typename TBound>
-void StaticFunction<TRet (TArgs...), TSize>::InvokerBound<TBound>::moveTo(
-    void* place)
-{
-    auto otherInvoker = new (place) InvokerBound(std::move(*this));
-    static_cast<void>(otherInvoker);
-}
-/// @endcond
-
-template <std::size_t TSize, typename TRet, typename... TArgs>
-typename StaticFunction<TRet (TArgs...), TSize>::Invoker*
-StaticFunction<TRet (TArgs...), TSize>::getInvoker()
-{
-    return reinterpret_cast<Invoker*>(&handler_);
-}
-
-template <std::size_t TSize, typename TRet, typename... TArgs>
-const typename StaticFunction<TRet (TArgs...), TSize>::Invoker*
-StaticFunction<TRet (TArgs...), TSize>::getInvoker() const
-{
-    return reinterpret_cast<const Invoker*>(&handler_);
-}
-
-template <std::size_t TSize, typename TRet, typename... TArgs>
-void StaticFunction<TRet (TArgs...), TSize>::destroyHandler()
-{
-    if (valid_) {
-        auto invoker = getInvoker();
-        invoker->~Invoker();
-    }
+    return Base::invokeHandler(std::forward<TArgs>(args)...);
 }
 
 template <std::size_t TSize, typename TRet, typename... TArgs>
@@ -416,26 +586,14 @@ void StaticFunction<TRet (TArgs...), TSize>::assignHandler(TFunc&& func)
 {
     typedef StaticFunction<TRet (TArgs...), TSize> ThisType;
     typedef typename std::decay<TFunc>::type DecayedFuncType;
-    typedef InvokerBound<DecayedFuncType> InvokerBoundType;
 
     static_assert(!std::is_same<ThisType, DecayedFuncType>::value,
         "Wrong function invocation");
 
-    static_assert(sizeof(InvokerBoundType) <= StorageAreaSize,
-        "Increase the TSize template argument of the StaticFucntion");
-
-    static_assert(alignof(Invoker) == alignof(InvokerBoundType),
-        "Alignment requirement for Invoker object must be the same as "
-        "alignment requirement for InvokerBoundType type object");
-
-    auto handlerPtr = new (&handler_) InvokerBoundType(std::forward<TFunc>(func));
-    static_cast<void>(handlerPtr);
-
+    Base::assignHandler(std::forward<TFunc>(func));
 }
 
 }  // namespace util
 
 }  // namespace embxx
 
-
-
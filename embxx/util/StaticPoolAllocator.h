@@ -21,10 +21,12 @@
 #include <cstddef>
 #include <type_traits>
 #include <array>
-#include <bitset>
 #include <limits>
+#include <algorithm>
+#include <iterator>
 
 #include "embxx/util/Assert.h"
+#include "embxx/util/AllocStats.h"
 
 namespace embxx
 {
@@ -35,6 +37,28 @@ namespace util
 namespace details
 {
 
+typedef unsigned long long StaticPoolAllocatorWord;
+
+static const std::size_t StaticPoolAllocatorWordBits =
+    static_cast<std::size_t>(
+        std::numeric_limits<StaticPoolAllocatorWord>::digits);
+
+inline
+std::size_t staticPoolAllocatorCountTrailingZeros(StaticPoolAllocatorWord word)
+{
+    GASSERT(word != 0U);
+#ifdef __GNUC__
+    return static_cast<std::size_t>(__builtin_ctzll(word));
+#else
+    std::size_t count = 0U;
+    while ((word & 0x1U) == 0U) {
+        word >>= 1U;
+        ++count;
+    }
+    return count;
+#endif
+}
+
 template <typename TTag, typename T, std::size_t TSize>
 struct StaticPoolAllocatorStorage
 {
@@ -44,13 +68,58 @@ struct StaticPoolAllocatorStorage
             std::alignment_of<T>::value
         >::type CellType;
 
+    typedef StaticPoolAllocatorWord Word;
+
+    static const std::size_t WordBits = StaticPoolAllocatorWordBits;
+
+    static const std::size_t NumOfWords =
+        (TSize + (WordBits - 1)) / WordBits;
+
+    static const std::size_t NumOfSummaryWords =
+        (NumOfWords + (WordBits - 1)) / WordBits;
+
+    // Bit per cell, set when the cell is allocated
+    static std::array<Word, NumOfWords> allocFlags_;
+
+    // Bit per allocFlags_ word, set when all the cells it covers are allocated
+    static std::array<Word, NumOfSummaryWords> fullWords_;
+
     static std::array<CellType, TSize> items_;
-    static std::bitset<TSize> allocFlags_;
 };
 
+template <typename TTag, typename T, std::size_t TSize>
+std::array<
+    typename StaticPoolAllocatorStorage<TTag, T, TSize>::Word,
+    StaticPoolAllocatorStorage<TTag, T, TSize>::NumOfWords>
+StaticPoolAllocatorStorage<TTag, T, TSize>::allocFlags_;
+
+template <typename TTag, typename T, std::size_t TSize>
+std::array<
+    typename StaticPoolAllocatorStorage<TTag, T, TSize>::Word,
+    StaticPoolAllocatorStorage<TTag, T, TSize>::NumOfSummaryWords>
+StaticPoolAllocatorStorage<TTag, T, TSize>::fullWords_;
+
+template <typename TTag, typename T, std::size_t TSize>
+std::array<
+    typename StaticPoolAllocatorStorage<TTag, T, TSize>::CellType,
+    TSize>
+StaticPoolAllocatorStorage<TTag, T, TSize>::items_;
+
+template <typename TTag, typename T, std::size_t TSize, typename TStats>
+struct StaticPoolAllocatorStats
+{
+    static TStats stats_;
+};
+
+template <typename TTag, typename T, std::size_t TSize, typename TStats>
+TStats StaticPoolAllocatorStats<TTag, T, TSize, TStats>::stats_;
+
 }  // namespace details
 
-template <typename TTag, typename T = void, std::size_t TSize = 1>
+template <typename TTag,
+          typename T = void,
+          std::size_t TSize = 1,
+          typename TStats = NoAllocStats>
 class StaticPoolAllocator
 {
     static_assert(
@@ -64,6 +133,7 @@ class StaticPoolAllocator
         "mustn't be pointer");
 
     typedef details::StaticPoolAllocatorStorage<TTag, T, TSize> Storage;
+    typedef details::StaticPoolAllocatorStats<TTag, T, TSize, TStats> Stats;
 
 public:
     typedef T value_type;
@@ -77,7 +147,7 @@ public:
     template <typename U>
     struct rebind
     {
-        typedef StaticPoolAllocator<TTag, U, TSize> other;
+        typedef StaticPoolAllocator<TTag, U, TSize, TStats> other;
     };
 
     StaticPoolAllocator() = default;
@@ -89,38 +159,40 @@ public:
 
     pointer allocate(size_type num)
     {
-        if (max_size() < num) {
+        if ((num == 0U) || (max_size() < num)) {
+            Stats::stats_.allocFailed(0U);
             return nullptr;
         }
 
-        auto allocBitset = numToBitset(num);
-
-        std::size_t idx = 0;
-        while (idx <= (Storage::allocFlags_.size() - num)) {
-            auto checkBitmask = Storage::allocFlags_ & allocBitset;
-            if (checkBitmask.none()) {
-                Storage::allocFlags_ |= allocBitset;
-                return &Storage::items_[idx];
-            }
+        std::size_t searchLength = 0U;
+        std::size_t idx = 0U;
+        if (num == 1U) {
+            idx = findFreeCell(searchLength);
+        }
+        else {
+            idx = findFreeRange(num, searchLength);
+        }
 
-            allocBitset <<= 1U;
-            ++idx;
+        if (TSize <= idx) {
+            Stats::stats_.allocFailed(searchLength);
+            return nullptr;
         }
-        return nullptr;
+
+        markAllocated(idx, num);
+        Stats::stats_.allocated(num, searchLength);
+        return reinterpret_cast<pointer>(&Storage::items_[idx]);
     }
 
     void deallocate(pointer ptr, size_type num)
     {
-        auto releaseBitset = numToBitset(num);
-
         auto& items = Storage::items_;
-        auto idxTmp = std::distance(&items[0], ptr);
-        GASSERT((0 <= idxTmp) && ((idxTmp + num) < items.size()));
+        auto idxTmp = std::distance(
+            &items[0],
+            reinterpret_cast<typename Storage::CellType*>(ptr));
+        GASSERT((0 <= idxTmp) && ((idxTmp + num) <= items.size()));
         auto idx = static_cast<size_type>(idxTmp);
-        releaseBitset <<= idx;
-
-        GASSERT((Storage::allocFlags_ & releaseBitset) == releaseBitset);
-        Storage::allocFlags_ ^= releaseBitset;
+        markReleased(idx, num);
+        Stats::stats_.deallocated(num);
     }
 
     constexpr size_type max_size() const
@@ -140,33 +212,139 @@ public:
         p->~U();
     }
 
+    /// @brief Get access to statistics of the pool.
+    /// @details The statistics are shared by all the allocators with
+    ///          the same template parameters.
+    static TStats& stats()
+    {
+        return Stats::stats_;
+    }
+
 private:
-    decltype(Storage::allocFlags_) numToBitset(size_type num)
+    typedef typename Storage::Word Word;
+    static const std::size_t WordBits = Storage::WordBits;
+    static const Word AllBits = ~(static_cast<Word>(0U));
+
+    static Word rangeMask(std::size_t bitIdx, std::size_t count)
+    {
+        GASSERT((0U < count) && ((bitIdx + count) <= WordBits));
+        if (count == WordBits) {
+            return AllBits;
+        }
+        return ((static_cast<Word>(1U) << count) - 1U) << bitIdx;
+    }
+
+    static std::size_t findFreeCell(std::size_t& searchLength)
+    {
+        auto& fullWords = Storage::fullWords_;
+        for (auto summaryIdx = 0U; summaryIdx < fullWords.size(); ++summaryIdx) {
+            ++searchLength;
+            auto notFull = ~fullWords[summaryIdx];
+            if (notFull == 0U) {
+                continue;
+            }
+
+            auto wordIdx =
+                (summaryIdx * WordBits) +
+                details::staticPoolAllocatorCountTrailingZeros(notFull);
+            if (Storage::allocFlags_.size() <= wordIdx) {
+                break;
+            }
+
+            auto freeBits = ~Storage::allocFlags_[wordIdx];
+            GASSERT(freeBits != 0U);
+            return
+                (wordIdx * WordBits) +
+                details::staticPoolAllocatorCountTrailingZeros(freeBits);
+        }
+        return TSize;
+    }
+
+    static std::size_t findFreeRange(std::size_t num, std::size_t& searchLength)
+    {
+        auto& flags = Storage::allocFlags_;
+        std::size_t idx = 0U;
+        while ((idx + num) <= TSize) {
+            ++searchLength;
+            // Skip allocated cells, whole words at a time when possible
+            auto wordIdx = idx / WordBits;
+            auto bitIdx = idx % WordBits;
+            auto freeBits = (~flags[wordIdx]) & (AllBits << bitIdx);
+            if (freeBits == 0U) {
+                idx = (wordIdx + 1) * WordBits;
+                continue;
+            }
+
+            idx = (wordIdx * WordBits) +
+                details::staticPoolAllocatorCountTrailingZeros(freeBits);
+            if (TSize < (idx + num)) {
+                break;
+            }
+
+            // Measure the run of free cells starting at idx
+            auto runEnd = idx;
+            while (runEnd < (idx + num)) {
+                wordIdx = runEnd / WordBits;
+                bitIdx = runEnd % WordBits;
+                auto usedBits = flags[wordIdx] & (AllBits << bitIdx);
+                if (usedBits == 0U) {
+                    runEnd = (wordIdx + 1) * WordBits;
+                    continue;
+                }
+
+                runEnd = (wordIdx * WordBits) +
+                    details::staticPoolAllocatorCountTrailingZeros(usedBits);
+                break;
+            }
+
+            if ((idx + num) <= runEnd) {
+                return idx;
+            }
+
+            idx = runEnd;
+        }
+        return TSize;
+    }
+
+    static void markAllocated(std::size_t idx, std::size_t num)
     {
-        typedef unsigned long long BitsetParamType;
-
-        static const std::size_t ChunkSize =
-            std::numeric_limits<BitsetParamType>::digits;
-
-        typedef decltype(Storage::allocFlags_) Bitset;
-        Bitset bitset;
-        auto remNum = num;
-        while (remNum >= ChunkSize) {
-            static const auto mask = ~(static_cast<BitsetParamType>(0));
-            bitset <<= ChunkSize;
-            bitset |= Bitset(mask);
-            remNum -= ChunkSize;
+        auto& flags = Storage::allocFlags_;
+        while (0U < num) {
+            auto wordIdx = idx / WordBits;
+            auto bitIdx = idx % WordBits;
+            auto count = std::min(num, WordBits - bitIdx);
+            auto mask = rangeMask(bitIdx, count);
+            GASSERT((flags[wordIdx] & mask) == 0U);
+            flags[wordIdx] |= mask;
+            if (flags[wordIdx] == AllBits) {
+                Storage::fullWords_[wordIdx / WordBits] |=
+                    (static_cast<Word>(1U) << (wordIdx % WordBits));
+            }
+            idx += count;
+            num -= count;
         }
+    }
 
-        auto lastMask = (static_cast<BitsetParamType>(1U) << remNum) - 1;
-        bitset <<= remNum;
-        bitset |= Bitset(lastMask);
-        return bitset;
+    static void markReleased(std::size_t idx, std::size_t num)
+    {
+        auto& flags = Storage::allocFlags_;
+        while (0U < num) {
+            auto wordIdx = idx / WordBits;
+            auto bitIdx = idx % WordBits;
+            auto count = std::min(num, WordBits - bitIdx);
+            auto mask = rangeMask(bitIdx, count);
+            GASSERT((flags[wordIdx] & mask) == mask);
+            flags[wordIdx] &= ~mask;
+            Storage::fullWords_[wordIdx / WordBits] &=
+                ~(static_cast<Word>(1U) << (wordIdx % WordBits));
+            idx += count;
+            num -= count;
+        }
     }
 };
 
-template <typename TTag, std::size_t TSize>
-class StaticPoolAllocator<TTag, void, TSize>
+template <typename TTag, std::size_t TSize, typename TStats>
+class StaticPoolAllocator<TTag, void, TSize, TStats>
 {
 public:
     typedef void value_type;
@@ -176,7 +354,7 @@ public:
     template <typename U>
     struct rebind
     {
-        typedef StaticPoolAllocator<TTag, U, TSize> other;
+        typedef StaticPoolAllocator<TTag, U, TSize, TStats> other;
     };
 
     StaticPoolAllocator() = default;
@@ -187,26 +365,28 @@ public:
     StaticPoolAllocator& operator=(StaticPoolAllocator&&) = default;
 };
 
-template <typename TTag, typename T, std::size_t TSize>
+template <typename TTag, typename T, std::size_t TSize, typename TStats>
 bool operator==(
-    const StaticPoolAllocator<TTag, T, TSize>,
-    const StaticPoolAllocator<TTag, T, TSize>)
+    const StaticPoolAllocator<TTag, T, TSize, TStats>,
+    const StaticPoolAllocator<TTag, T, TSize, TStats>)
 {
     return true;
 }
 
-template <typename TTag1, typename T1, std::size_t TSize1, typename TTag2, typename T2, std::size_t TSize2>
+template <typename TTag1, typename T1, std::size_t TSize1, typename TStats1,
+          typename TTag2, typename T2, std::size_t TSize2, typename TStats2>
 bool operator==(
-    const StaticPoolAllocator<TTag1, T1, TSize1>,
-    const StaticPoolAllocator<TTag2, T2, TSize2>)
+    const StaticPoolAllocator<TTag1, T1, TSize1, TStats1>,
+    const StaticPoolAllocator<TTag2, T2, TSize2, TStats2>)
 {
     return false;
 }
 
-template <typename TTag1, typename T1, std::size_t TSize1, typename TTag2, typename T2, std::size_t TSize2>
+template <typename TTag1, typename T1, std::size_t TSize1, typename TStats1,
+          typename TTag2, typename T2, std::size_t TSize2, typename TStats2>
 bool operator!=(
-    const StaticPoolAllocator<TTag1, T1, TSize1> a1,
-    const StaticPoolAllocator<TTag2, T2, TSize2> a2)
+    const StaticPoolAllocator<TTag1, T1, TSize1, TStats1> a1,
+    const StaticPoolAllocator<TTag2, T2, TSize2, TStats2> a2)
 {
     return !(a1 == a2);
 }
@@ -0,0 +1,231 @@
+//
+// Copyright 2014 (C). Alex Robenko. All rights reserved.
+//
+
+// This library is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/// @file embxx/util/StaticUniqueFunction.h
+/// Provides StaticUniqueFunction class.
+
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "embxx/util/StaticFunction.h"
+
+namespace embxx
+{
+
+namespace util
+{
+
+/// @addtogroup util
+/// @{
+
+/// @brief Generic declaration of StaticUniqueFunction.
+/// @details This declaration doesn't have a body, see specialisation.
+/// @headerfile embxx/util/StaticUniqueFunction.h
+template <typename TSignature, std::size_t TSize = sizeof(void*) * 3>
+class StaticUniqueFunction;
+
+/// @brief Move-only Static Function.
+/// @details Similar to StaticFunction, it doesn't use dynamic memory
+///          allocation and stores provided functor in the internal storage
+///          area. However it cannot be copied, only moved, which allows
+///          storing functors that are not copyable themselves (for example
+///          lambdas that capture std::unique_ptr).
+///
+///          The same as StaticFunction, besides the storage area the object
+///          contains only pointers to the invocation and manager functions.
+///          When the stored functor is trivially copyable, the move operation
+///          just copies sizeof(functor) bytes with memcpy() without invoking
+///          any constructors or destructors.
+///
+///          This is template specialisation of the following class definition
+///          @code
+///          // TSignature is a combination of return value an arguments: TRet(TArgs...)
+///          template <typename TSignature, std::size_t TSize = sizeof(void*) * 3>
+///          class StaticUniqueFunction;
+///          @endcode
+/// @tparam TSize Size of the space required to store provided functor.
+/// @tparam TRet Return type of the function
+/// @tparam TArgs Argument types
+/// @headerfile embxx/util/StaticUniqueFunction.h
+template <std::size_t TSize, typename TRet, typename... TArgs>
+class StaticUniqueFunction<TRet (TArgs...), TSize> :
+    private details::StaticFunctionBase<TSize, false, TRet, TArgs...>
+{
+    typedef details::StaticFunctionBase<TSize, false, TRet, TArgs...> Base;
+
+public:
+    /// @brief Result type
+    typedef TRet result_type;
+
+    static const std::size_t Size = TSize;
+
+    /// @brief Default constructor
+    StaticUniqueFunction();
+
+    /// @brief Constructs StaticUniqueFunction object out of provided functor
+    /// @pre TFunc invocation must have the same signature as StaticUniqueFunction
+    /// @pre @code sizeof(TFunc) <= TSize @endcode
+    template <typename TFunc>
+    explicit StaticUniqueFunction(TFunc&& func);
+
+    /// @brief Copy constructor is deleted
+    StaticUniqueFunction(const StaticUniqueFunction& other) = delete;
+
+    /// @brief Move constructor
+    /// @post Other function becomes invalid: @code (!other) == true @endcode
+    StaticUniqueFunction(StaticUniqueFunction&& other);
+
+    /// @brief Destructor
+    ~StaticUniqueFunction();
+
+    /// @brief Copy assignment operator is deleted
+    StaticUniqueFunction& operator=(const StaticUniqueFunction& other) = delete;
+
+    /// @brief Move assignment operator
+    /// @post Other function becomes invalid: @code (!other) == true @endcode
+    StaticUniqueFunction& operator=(StaticUniqueFunction&& other);
+
+    /// @brief Invalidates current function.
+    /// @post This function becomes invalid: @code (!(*this)) == true @endcode
+    StaticUniqueFunction& operator=(std::nullptr_t);
+
+    /// @brief Assigns new functor to current function.
+    /// @pre TFunc invocation must have the same signature as StaticUniqueFunction
+    /// @pre @code sizeof(TFunc) <= TSize @endcode
+    /// @post This function becomes valid: @code (!(*this)) == false @endcode
+    template <typename TFunc>
+    StaticUniqueFunction& operator=(TFunc&& func);
+
+    /// @brief Boolean conversion operator.
+    /// @return Returns true if and only if current function is valid, i.e.
+    ///         may be invoked using operator().
+    operator bool() const;
+
+    /// @brief Negation operator.
+    /// @return Returns true if and only if current function is invalid, i.e.
+    ///         may NOT be invoked using operator().
+    bool operator!() const;
+
+    /// @brief Function invocation operator.
+    /// @details Invokes operator() of the stored functor with provided arguments
+    /// @return What functor returns
+    /// @pre The function object is valid, i.e. has functor assigned to it.
+    TRet operator()(TArgs... args) const;
+
+private:
+    template <typename TFunc>
+    void assignHandler(TFunc&& func);
+};
+
+/// @}
+
+// Implementation
+template <std::size_t TSize, typename TRet, typename... TArgs>
+StaticUniqueFunction<TRet (TArgs...), TSize>::StaticUniqueFunction()
+{
+}
+
+template <std::size_t TSize, typename TRet, typename... TArgs>
+template <typename TFunc>
+StaticUniqueFunction<TRet (TArgs...), TSize>::StaticUniqueFunction(TFunc&& func)
+{
+    assignHandler(std::forward<TFunc>(func));
+}
+
+template <std::size_t TSize, typename TRet, typename... TArgs>
+StaticUniqueFunction<TRet (TArgs...), TSize>::StaticUniqueFunction(
+    StaticUniqueFunction&& other)
+    : Base()
+{
+    Base::moveHandlerFrom(other);
+}
+
+template <std::size_t TSize, typename TRet, typename... TArgs>
+StaticUniqueFunction<TRet (TArgs...), TSize>::~StaticUniqueFunction()
+{
+    Base::destroyHandler();
+}
+
+template <std::size_t TSize, typename TRet, typename... TArgs>
+StaticUniqueFunction<TRet (TArgs...), TSize>&
+StaticUniqueFunction<TRet (TArgs...), TSize>::operator=(StaticUniqueFunction&& other)
+{
+    if (&other == this) {
+        return *this;
+    }
+
+    Base::destroyHandler();
+    Base::moveHandlerFrom(other);
+    return *this;
+}
+
+template <std::size_t TSize, typename TRet, typename... TArgs>
+StaticUniqueFunction<TRet (TArgs...), TSize>&
+StaticUniqueFunction<TRet (TArgs...), TSize>::operator=(std::nullptr_t)
+{
+    Base::destroyHandler();
+    return *this;
+}
+
+template <std::size_t TSize, typename TRet, typename... TArgs>
+template <typename TFunc>
+StaticUniqueFunction<TRet (TArgs...), TSize>&
+StaticUniqueFunction<TRet (TArgs...), TSize>::operator=(TFunc&& func)
+{
+    Base::destroyHandler();
+    assignHandler(std::forward<TFunc>(func));
+    return *this;
+}
+
+template <std::size_t TSize, typename TRet, typename... TArgs>
+StaticUniqueFunction<TRet (TArgs...), TSize>::operator bool() const
+{
+    return Base::valid();
+}
+
+template <std::size_t TSize, typename TRet, typename... TArgs>
+bool StaticUniqueFunction<TRet (TArgs...), TSize>::operator!() const
+{
+    return !Base::valid();
+}
+
+template <std::size_t TSize, typename TRet, typename... TArgs>
+TRet StaticUniqueFunction<TRet (TArgs...), TSize>::operator()(
+    TArgs... args) const
+{
+    return Base::invokeHandler(std::forward<TArgs>(args)...);
+}
+
+template <std::size_t TSize, typename TRet, typename... TArgs>
+template <typename TFunc>
+void StaticUniqueFunction<TRet (TArgs...), TSize>::assignHandler(TFunc&& func)
+{
+    typedef StaticUniqueFunction<TRet (TArgs...), TSize> ThisType;
+    typedef typename std::decay<TFunc>::type DecayedFuncType;
+
+    static_assert(!std::is_same<ThisType, DecayedFuncType>::value,
+        "Wrong function invocation");
+
+    Base::assignHandler(std::forward<TFunc>(func));
+}
+
+}  // namespace util
+
+}  // namespace embxx
@@ -275,6 +275,107 @@ TValue tupleAccumulate(TTuple&& tuple, const TValue& value, TFunc&& func)
                 std::forward<TFunc>(func));
 }
 
+//----------------------------------------
+
+/// @brief Compile time sequence of indices.
+/// @details Used to expand parameter packs over tuple elements or array
+///          entries.
+template <std::size_t... TIndices>
+struct IndexSequence
+{
+};
+
+/// @cond DOCUMENT_INDEX_SEQUENCE_CONCAT
+template <typename TFirst, typename TSecond>
+struct IndexSequenceConcat;
+
+template <std::size_t... TFirst, std::size_t... TSecond>
+struct IndexSequenceConcat<IndexSequence<TFirst...>, IndexSequence<TSecond...> >
+{
+    typedef IndexSequence<TFirst..., (sizeof...(TFirst) + TSecond)...> Type;
+};
+/// @endcond
+
+/// @brief Generate IndexSequence<0, 1, ..., TCount - 1>.
+/// @details The recursion depth is logarithmic, so long sequences don't hit
+///          template instantiation depth limit.
+template <std::size_t TCount>
+struct MakeIndexSequence
+{
+    /// @brief Result type
+    typedef typename IndexSequenceConcat<
+        typename MakeIndexSequence<TCount / 2>::Type,
+        typename MakeIndexSequence<TCount - (TCount / 2)>::Type
+    >::Type Type;
+};
+
+/// @cond DOCUMENT_MAKE_INDEX_SEQUENCE_SPECIALISATION
+template <>
+struct MakeIndexSequence<0>
+{
+    typedef IndexSequence<> Type;
+};
+
+template <>
+struct MakeIndexSequence<1>
+{
+    typedef IndexSequence<0> Type;
+};
+/// @endcond
+
+//----------------------------------------
+
+/// @cond DOCUMENT_TUPLE_FOR_EACH_UNTIL_HELPER
+template <typename TTuple, typename TFunc>
+bool tupleForEachUntilInternal(TTuple&& tuple, TFunc&& func, IndexSequence<>)
+{
+    static_cast<void>(tuple);
+    static_cast<void>(func);
+    return true;
+}
+
+template <typename TTuple, typename TFunc, std::size_t TIdx, std::size_t... TRest>
+bool tupleForEachUntilInternal(
+    TTuple&& tuple,
+    TFunc&& func,
+    IndexSequence<TIdx, TRest...>)
+{
+    return
+        func(std::get<TIdx>(std::forward<TTuple>(tuple))) &&
+        tupleForEachUntilInternal(
+            std::forward<TTuple>(tuple),
+            std::forward<TFunc>(func),
+            IndexSequence<TRest...>());
+}
+/// @endcond
+
+/// @brief Iterate over elements of tuple and execute provided functor until
+///        it returns false.
+/// @details Requires functor to have operator() with one of the following
+///          signatures depending on const specification of the provided tuple.
+///          @li @code template <typename T> bool operator()(T& element); @endcode
+///          @li @code template <typename T> bool operator()(const T& element); @endcode
+///          The remaining elements are not visited after the functor
+///          returns false, which suits operations that must stop on the
+///          first failure.
+/// @param[in] tuple Tuple
+/// @param[in] func Functor
+/// @return true if the functor returned true for all the elements, false
+///         otherwise.
+/// @pre tuple is any variant of std::tuple
+template <typename TTuple, typename TFunc>
+bool tupleForEachUntil(TTuple&& tuple, TFunc&& func)
+{
+    typedef typename std::decay<TTuple>::type Tuple;
+    static_assert(IsTuple<Tuple>::Value, "TTuple must be std::tuple");
+    static const std::size_t TupleSize = std::tuple_size<Tuple>::value;
+
+    return tupleForEachUntilInternal(
+        std::forward<TTuple>(tuple),
+        std::forward<TFunc>(func),
+        typename MakeIndexSequence<TupleSize>::Type());
+}
+
 /// @}
 
 }  // namespace util
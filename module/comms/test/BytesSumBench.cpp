@@ -0,0 +1,138 @@
+//
+// Copyright 2014 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+// Measures throughput (GB/s) of BytesSum checksum calculation: byte by byte
+// loop used for non-pointer iterators, portable 64 bit lanes, SSE2, AVX2
+// and the dispatched calculation of contiguous buffers.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "embxx/comms/protocol/checksum/BytesSum.h"
+
+namespace
+{
+
+namespace checksum = embxx::comms::protocol::checksum;
+
+struct SumTraits
+{
+    static const std::size_t ChecksumLen = 4;
+    static const std::uint32_t ChecksumBase = 0;
+};
+
+typedef checksum::BytesSum<SumTraits> Sum;
+
+volatile std::uint64_t sink = 0;
+
+template <typename TFunc>
+void measure(const char* name, std::vector<std::uint8_t>& data, TFunc&& func)
+{
+    static const std::size_t TotalBytes = 256 * 1024 * 1024;
+    auto iterations = TotalBytes / data.size();
+    std::uint64_t result = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t idx = 0; idx < iterations; ++idx) {
+        // Feeding the result back prevents hoisting of the calculation
+        data[0] = static_cast<std::uint8_t>(result);
+        result += func(data);
+    }
+    auto end = std::chrono::steady_clock::now();
+    sink = result;
+
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    auto gbps =
+        static_cast<double>(iterations * data.size()) / static_cast<double>(ns);
+    std::printf("%6zu bytes, %-16s %8.2f GB/s\n", data.size(), name, gbps);
+}
+
+template <typename TFunc>
+std::uint64_t sumBlocks(const std::vector<std::uint8_t>& data, TFunc&& func)
+{
+    const std::uint8_t* bytes = &data[0];
+    auto* bytesEnd = bytes + data.size();
+    auto sum = func(bytes, data.size());
+    while (bytes != bytesEnd) {
+        sum += *bytes;
+        ++bytes;
+    }
+    return sum;
+}
+
+void run(std::size_t size)
+{
+    std::vector<std::uint8_t> data(size);
+    for (std::size_t idx = 0; idx < size; ++idx) {
+        data[idx] = static_cast<std::uint8_t>((idx * 131) + 17);
+    }
+
+    measure("byte by byte", data,
+        [](const std::vector<std::uint8_t>& buf) -> std::uint64_t
+        {
+            auto iter = buf.begin();
+            return Sum::calc(iter, buf.size());
+        });
+
+    measure("64 bit lanes", data,
+        [](const std::vector<std::uint8_t>& buf) -> std::uint64_t
+        {
+            return sumBlocks(buf, &checksum::bytes_sum_details::sumBlocksPortable);
+        });
+
+#ifdef __SSE2__
+    measure("SSE2", data,
+        [](const std::vector<std::uint8_t>& buf) -> std::uint64_t
+        {
+            return sumBlocks(buf, &checksum::bytes_sum_details::sumBlocksSse2);
+        });
+#endif // #ifdef __SSE2__
+
+#ifdef EMBXX_BYTES_SUM_X86_AVX2
+    if (checksum::bytes_sum_details::avx2Supported()) {
+        measure("AVX2", data,
+            [](const std::vector<std::uint8_t>& buf) -> std::uint64_t
+            {
+                return sumBlocks(buf, &checksum::bytes_sum_details::sumBlocksAvx2);
+            });
+    }
+#endif // #ifdef EMBXX_BYTES_SUM_X86_AVX2
+
+    measure("BytesSum::calc", data,
+        [](const std::vector<std::uint8_t>& buf) -> std::uint64_t
+        {
+            const std::uint8_t* iter = &buf[0];
+            return Sum::calc(iter, buf.size());
+        });
+}
+
+}  // namespace
+
+int main(int argc, const char* argv[])
+{
+    static_cast<void>(argc);
+    static_cast<void>(argv);
+
+    run(64);
+    run(256);
+    run(1024);
+    run(4 * 1024);
+    run(64 * 1024);
+    return 0;
+}
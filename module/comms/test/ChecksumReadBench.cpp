@@ -0,0 +1,207 @@
+//
+// Copyright 2014 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+// Measures time of ChecksumLayer::read() of good and corrupted frames
+// with every checksum verification strategy.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <initializer_list>
+#include <tuple>
+#include <vector>
+
+#include "embxx/comms/Message.h"
+#include "embxx/comms/MessageHandler.h"
+#include "embxx/comms/MsgAllocators.h"
+#include "embxx/comms/field.h"
+#include "embxx/comms/protocol.h"
+#include "embxx/comms/protocol/checksum/Crc.h"
+#include "embxx/comms/protocol/checksum/BytesSum.h"
+
+namespace
+{
+
+namespace comms = embxx::comms;
+namespace checksum = embxx::comms::protocol::checksum;
+
+static const std::size_t MaxPayload = 4096;
+
+struct CrcTraits
+{
+    static const std::size_t ChecksumLen = 4;
+};
+
+struct SumTraits
+{
+    static const std::size_t ChecksumLen = 2;
+    static const std::size_t ChecksumBase = 0;
+};
+
+template <typename TChecksumCalc, typename TVerification>
+struct Traits
+{
+    typedef comms::traits::endian::Big Endianness;
+    typedef TVerification ChecksumVerification;
+    typedef const char* ReadIterator;
+    typedef char* WriteIterator;
+    static const std::size_t MsgIdLen = 1;
+    static const std::size_t ChecksumLen = TChecksumCalc::ChecksumLen;
+};
+
+template <typename TTraits>
+class Handler;
+
+template <typename TTraits>
+using MsgBase = comms::Message<Handler<TTraits>, TTraits>;
+
+template <typename TTraits>
+struct PayloadFields
+{
+    typedef std::tuple<
+        comms::field::ArrayListValue<std::uint8_t, TTraits, MaxPayload, 2>
+    > Type;
+};
+
+template <typename TTraits>
+class PayloadMsg : public comms::MetaMessageBase<
+                            0,
+                            MsgBase<TTraits>,
+                            PayloadMsg<TTraits>,
+                            typename PayloadFields<TTraits>::Type>
+{
+};
+
+template <typename TTraits>
+struct AllMessages
+{
+    typedef std::tuple<PayloadMsg<TTraits> > Type;
+};
+
+template <typename TTraits>
+class Handler : public comms::MessageHandler<
+                            MsgBase<TTraits>,
+                            typename AllMessages<TTraits>::Type>
+{
+};
+
+template <typename TChecksumCalc, typename TVerification>
+struct Stack
+{
+    typedef Traits<TChecksumCalc, TVerification> StackTraits;
+
+    typedef typename AllMessages<StackTraits>::Type Messages;
+
+    typedef comms::protocol::MsgDataLayer<MsgBase<StackTraits> > MsgDataLayer;
+
+    typedef comms::protocol::MsgIdLayer<
+        Messages,
+        comms::InPlaceMsgAllocator<Messages>,
+        StackTraits,
+        MsgDataLayer> MsgIdLayer;
+
+    typedef comms::protocol::ChecksumLayer<
+        StackTraits,
+        TChecksumCalc,
+        MsgIdLayer> Type;
+
+    typedef PayloadMsg<StackTraits> Msg;
+};
+
+volatile std::uint64_t sink = 0;
+
+template <typename TFunc>
+double nsPerOp(std::size_t iterations, TFunc&& func)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t idx = 0; idx < iterations; ++idx) {
+        func();
+    }
+    auto end = std::chrono::steady_clock::now();
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    return static_cast<double>(ns) / static_cast<double>(iterations);
+}
+
+template <typename TChecksumCalc, typename TVerification>
+void measure(const char* calcName, const char* verificationName, std::size_t payload)
+{
+    typedef Stack<TChecksumCalc, TVerification> StackType;
+    typename StackType::Type stack;
+
+    typename StackType::Msg msg;
+    auto& field = std::get<0>(msg.getFields());
+    field.resize(payload);
+    for (std::size_t idx = 0; idx < payload; ++idx) {
+        field[idx] = static_cast<std::uint8_t>((idx * 131) + 17);
+    }
+
+    std::vector<char> frame(stack.length(msg));
+    char* writeIter = &frame[0];
+    stack.write(msg, writeIter, frame.size());
+
+    auto corruptedFrame = frame;
+    corruptedFrame[corruptedFrame.size() / 2] ^= 0x5a;
+
+    auto iterations = (16 * 1024 * 1024) / (payload + 64);
+    auto readFrame =
+        [&stack, iterations](const std::vector<char>& buf) -> double
+        {
+            return nsPerOp(iterations,
+                [&stack, &buf]()
+                {
+                    typename StackType::Type::MsgPtr readMsg;
+                    const char* readIter = &buf[0];
+                    auto es = stack.read(readMsg, readIter, buf.size());
+                    sink = static_cast<std::uint64_t>(es);
+                });
+        };
+
+    auto goodNs = readFrame(frame);
+    auto corruptedNs = readFrame(corruptedFrame);
+    std::printf("%-10s %-26s %5zu bytes, good: %9.1f ns, corrupted: %9.1f ns\n",
+        calcName, verificationName, payload, goodNs, corruptedNs);
+}
+
+template <typename TChecksumCalc>
+void run(const char* calcName, std::size_t payload)
+{
+    measure<TChecksumCalc, comms::traits::checksum::VerifyBeforeProcessing>(
+        calcName, "VerifyBeforeProcessing", payload);
+    measure<TChecksumCalc, comms::traits::checksum::VerifyAfterProcessing>(
+        calcName, "VerifyAfterProcessing", payload);
+}
+
+}  // namespace
+
+int main(int argc, const char* argv[])
+{
+    static_cast<void>(argc);
+    static_cast<void>(argv);
+
+    typedef checksum::CrcBasic<CrcTraits> Crc32;
+    typedef checksum::BytesSum<SumTraits> Sum16;
+
+    for (auto payload : {16U, 256U, 4096U}) {
+        run<Crc32>("CRC-32", payload);
+    }
+
+    for (auto payload : {16U, 256U, 4096U}) {
+        run<Sum16>("BytesSum", payload);
+    }
+    return 0;
+}
@@ -0,0 +1,270 @@
+//
+// Copyright 2014 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+// Measures time of ChecksumLayer::write() with different write iterators:
+// pointer to buffer (checksum of the written data calculated in the second
+// pass over contiguous buffer), std::back_insert_iterator (write() followed
+// by update()), and ChecksumWriteIterator wrapping both of them (checksum
+// accumulated one byte at a time while the message is being written).
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <tuple>
+#include <vector>
+
+#include "embxx/comms/Message.h"
+#include "embxx/comms/MessageHandler.h"
+#include "embxx/comms/MsgAllocators.h"
+#include "embxx/comms/field.h"
+#include "embxx/comms/protocol.h"
+#include "embxx/comms/protocol/checksum/Crc.h"
+#include "embxx/comms/protocol/checksum/BytesSum.h"
+#include "embxx/comms/protocol/checksum/ChecksumWriteIterator.h"
+
+namespace
+{
+
+namespace comms = embxx::comms;
+namespace checksum = embxx::comms::protocol::checksum;
+
+static const std::size_t MaxPayload = 4096;
+
+struct CrcTraits
+{
+    static const std::size_t ChecksumLen = 4;
+};
+
+struct SumTraits
+{
+    static const std::size_t ChecksumLen = 2;
+    static const std::size_t ChecksumBase = 0;
+};
+
+template <typename TChecksumCalc, typename TWriteIter>
+struct Traits
+{
+    typedef comms::traits::endian::Big Endianness;
+    typedef comms::traits::checksum::VerifyBeforeProcessing ChecksumVerification;
+    typedef const char* ReadIterator;
+    typedef TWriteIter WriteIterator;
+    static const std::size_t MsgIdLen = 1;
+    static const std::size_t ChecksumLen = TChecksumCalc::ChecksumLen;
+};
+
+template <typename TTraits>
+class Handler;
+
+template <typename TTraits>
+using MsgBase = comms::Message<Handler<TTraits>, TTraits>;
+
+template <typename TTraits>
+struct PayloadFields
+{
+    typedef std::tuple<
+        comms::field::ArrayListValue<std::uint8_t, TTraits, MaxPayload, 2>
+    > Type;
+};
+
+template <typename TTraits>
+class PayloadMsg : public comms::MetaMessageBase<
+                            0,
+                            MsgBase<TTraits>,
+                            PayloadMsg<TTraits>,
+                            typename PayloadFields<TTraits>::Type>
+{
+};
+
+template <typename TTraits>
+struct AllMessages
+{
+    typedef std::tuple<PayloadMsg<TTraits> > Type;
+};
+
+template <typename TTraits>
+class Handler : public comms::MessageHandler<
+                            MsgBase<TTraits>,
+                            typename AllMessages<TTraits>::Type>
+{
+};
+
+template <typename TChecksumCalc, typename TWriteIter>
+struct Stack
+{
+    typedef Traits<TChecksumCalc, TWriteIter> StackTraits;
+
+    typedef comms::protocol::MsgDataLayer<MsgBase<StackTraits> > MsgDataLayer;
+
+    typedef comms::protocol::MsgIdLayer<
+        typename AllMessages<StackTraits>::Type,
+        comms::DynMemMsgAllocator,
+        StackTraits,
+        MsgDataLayer> MsgIdLayer;
+
+    typedef comms::protocol::ChecksumLayer<
+        StackTraits,
+        TChecksumCalc,
+        MsgIdLayer> Type;
+
+    typedef PayloadMsg<StackTraits> Msg;
+};
+
+volatile std::uint64_t sink = 0;
+
+template <typename TFunc>
+double nsPerOp(std::size_t iterations, TFunc&& func)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t idx = 0; idx < iterations; ++idx) {
+        func();
+    }
+    auto end = std::chrono::steady_clock::now();
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    return static_cast<double>(ns) / static_cast<double>(iterations);
+}
+
+template <typename TMsg>
+void fillPayload(TMsg& msg, std::size_t payload)
+{
+    auto& field = std::get<0>(msg.getFields());
+    field.resize(payload);
+    for (std::size_t idx = 0; idx < payload; ++idx) {
+        field[idx] = static_cast<std::uint8_t>((idx * 131) + 17);
+    }
+}
+
+template <typename TChecksumCalc>
+double pointerWrite(std::size_t payload, std::size_t iterations)
+{
+    typedef Stack<TChecksumCalc, char*> StackType;
+    typename StackType::Type stack;
+    typename StackType::Msg msg;
+    fillPayload(msg, payload);
+
+    std::vector<char> buf(stack.length(msg));
+    return nsPerOp(iterations,
+        [&]()
+        {
+            char* iter = &buf[0];
+            auto es = stack.write(msg, iter, buf.size());
+            sink = static_cast<std::uint64_t>(es) + static_cast<std::uint8_t>(buf.back());
+        });
+}
+
+template <typename TChecksumCalc>
+double backInsertWriteUpdate(std::size_t payload, std::size_t iterations)
+{
+    typedef std::back_insert_iterator<std::vector<char> > WriteIter;
+    typedef Stack<TChecksumCalc, WriteIter> StackType;
+    typename StackType::Type stack;
+    typename StackType::Msg msg;
+    fillPayload(msg, payload);
+
+    std::vector<char> buf;
+    buf.reserve(stack.length(msg));
+    return nsPerOp(iterations,
+        [&]()
+        {
+            buf.clear();
+            WriteIter iter(buf);
+            auto es = stack.write(msg, iter, buf.capacity());
+            if (es == comms::ErrorStatus::UpdateRequired) {
+                char* updateIter = &buf[0];
+                es = stack.update(updateIter, buf.size());
+            }
+            sink = static_cast<std::uint64_t>(es) + static_cast<std::uint8_t>(buf.back());
+        });
+}
+
+template <typename TChecksumCalc>
+double backInsertAccumulate(std::size_t payload, std::size_t iterations)
+{
+    typedef checksum::ChecksumWriteIterator<
+        std::back_insert_iterator<std::vector<char> >,
+        TChecksumCalc> WriteIter;
+    typedef Stack<TChecksumCalc, WriteIter> StackType;
+    typename StackType::Type stack;
+    typename StackType::Msg msg;
+    fillPayload(msg, payload);
+
+    std::vector<char> buf;
+    buf.reserve(stack.length(msg));
+    return nsPerOp(iterations,
+        [&]()
+        {
+            buf.clear();
+            WriteIter iter(std::back_inserter(buf));
+            auto es = stack.write(msg, iter, buf.capacity());
+            sink = static_cast<std::uint64_t>(es) + static_cast<std::uint8_t>(buf.back());
+        });
+}
+
+template <typename TChecksumCalc>
+double pointerAccumulate(std::size_t payload, std::size_t iterations)
+{
+    typedef checksum::ChecksumWriteIterator<char*, TChecksumCalc> WriteIter;
+    typedef Stack<TChecksumCalc, WriteIter> StackType;
+    typename StackType::Type stack;
+    typename StackType::Msg msg;
+    fillPayload(msg, payload);
+
+    std::vector<char> buf(stack.length(msg));
+    return nsPerOp(iterations,
+        [&]()
+        {
+            WriteIter iter(&buf[0]);
+            auto es = stack.write(msg, iter, buf.size());
+            sink = static_cast<std::uint64_t>(es) + static_cast<std::uint8_t>(buf.back());
+        });
+}
+
+template <typename TChecksumCalc>
+void run(const char* name, std::size_t payload)
+{
+    auto iterations = (16 * 1024 * 1024) / (payload + 64);
+    std::printf("%-10s %5zu bytes, pointer:                   %10.1f ns\n",
+        name, payload, pointerWrite<TChecksumCalc>(payload, iterations));
+    std::printf("%-10s %5zu bytes, pointer + accumulator:     %10.1f ns\n",
+        name, payload, pointerAccumulate<TChecksumCalc>(payload, iterations));
+    std::printf("%-10s %5zu bytes, back_inserter + update():  %10.1f ns\n",
+        name, payload, backInsertWriteUpdate<TChecksumCalc>(payload, iterations));
+    std::printf("%-10s %5zu bytes, back_inserter + accumulator: %8.1f ns\n",
+        name, payload, backInsertAccumulate<TChecksumCalc>(payload, iterations));
+}
+
+}  // namespace
+
+int main(int argc, const char* argv[])
+{
+    static_cast<void>(argc);
+    static_cast<void>(argv);
+
+    typedef checksum::CrcBasic<CrcTraits> Crc32;
+    typedef checksum::BytesSum<SumTraits> Sum16;
+
+    run<Crc32>("CRC-32", 16);
+    run<Crc32>("CRC-32", 64);
+    run<Crc32>("CRC-32", 256);
+    run<Crc32>("CRC-32", 4096);
+    run<Sum16>("BytesSum", 16);
+    run<Sum16>("BytesSum", 64);
+    run<Sum16>("BytesSum", 256);
+    run<Sum16>("BytesSum", 4096);
+    return 0;
+}
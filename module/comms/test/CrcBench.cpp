@@ -0,0 +1,136 @@
+//
+// Copyright 2014 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+// Measures throughput (GB/s) of the CRC calculators on contiguous buffers:
+// CrcBasic with one and eight lookup tables, Crc32c in software and with
+// SSE4.2 instruction, CrcFold table driven and folded with PCLMULQDQ.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "embxx/comms/protocol/checksum/Crc.h"
+#include "embxx/comms/protocol/checksum/Crc32c.h"
+#include "embxx/comms/protocol/checksum/CrcFold.h"
+
+namespace
+{
+
+namespace checksum = embxx::comms::protocol::checksum;
+
+template <std::size_t TLen>
+struct CrcTraits
+{
+    static const std::size_t ChecksumLen = TLen;
+};
+
+typedef checksum::crc_details::CrcFoldEngine<std::uint32_t, 32, 0x04C11DB7> Fold32Engine;
+typedef checksum::crc_details::CrcFoldEngine<std::uint64_t, 64, 0x42F0E1EBA9EA3693ULL> Fold64Engine;
+
+volatile std::uint64_t sink = 0;
+
+template <typename TFunc>
+void measure(const char* name, std::vector<std::uint8_t>& data, TFunc&& func)
+{
+    static const std::size_t TotalBytes = 256 * 1024 * 1024;
+    auto iterations = TotalBytes / data.size();
+    std::uint64_t result = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t idx = 0; idx < iterations; ++idx) {
+        // Feeding the result back prevents hoisting of the calculation
+        data[0] = static_cast<std::uint8_t>(result);
+        result ^= func(&data[0], data.size());
+    }
+    auto end = std::chrono::steady_clock::now();
+    sink = result;
+
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    auto gbps =
+        static_cast<double>(iterations * data.size()) / static_cast<double>(ns);
+    std::printf("%8zu bytes, %-24s %8.2f GB/s\n", data.size(), name, gbps);
+}
+
+template <typename TCrc>
+std::uint64_t calc(const std::uint8_t* bytes, std::size_t size)
+{
+    return TCrc::calc(bytes, size);
+}
+
+void run(std::size_t size)
+{
+    std::vector<std::uint8_t> data(size);
+    for (std::size_t idx = 0; idx < size; ++idx) {
+        data[idx] = static_cast<std::uint8_t>((idx * 131) + 17);
+    }
+
+    measure("CrcBasic<4, 1>", data, &calc<checksum::CrcBasic<CrcTraits<4>, 1> >);
+    measure("CrcBasic<4, 8>", data, &calc<checksum::CrcBasic<CrcTraits<4>, 8> >);
+    measure("Crc32c software", data,
+        [](const std::uint8_t* bytes, std::size_t len) -> std::uint64_t
+        {
+            return checksum::crc_details::Crc32cEngine::processSoftware(0, bytes, len);
+        });
+#ifdef EMBXX_CRC32C_X86_HARDWARE
+    if (checksum::crc_details::Crc32cEngine::hardwareSupported()) {
+        measure("Crc32c SSE4.2", data,
+            [](const std::uint8_t* bytes, std::size_t len) -> std::uint64_t
+            {
+                return checksum::crc_details::Crc32cEngine::processHardware(0, bytes, len);
+            });
+    }
+#endif // #ifdef EMBXX_CRC32C_X86_HARDWARE
+
+    measure("CrcFold<4> table", data,
+        [](const std::uint8_t* bytes, std::size_t len) -> std::uint64_t
+        {
+            return Fold32Engine::processSoftware(0, bytes, len);
+        });
+    measure("CrcFold<8> table", data,
+        [](const std::uint8_t* bytes, std::size_t len) -> std::uint64_t
+        {
+            return Fold64Engine::processSoftware(0, bytes, len);
+        });
+#ifdef EMBXX_CRC_FOLD_X86_HARDWARE
+    if (Fold32Engine::hardwareSupported()) {
+        measure("CrcFold<4> PCLMULQDQ", data,
+            [](const std::uint8_t* bytes, std::size_t len) -> std::uint64_t
+            {
+                return Fold32Engine::processHardware(0, bytes, len);
+            });
+        measure("CrcFold<8> PCLMULQDQ", data,
+            [](const std::uint8_t* bytes, std::size_t len) -> std::uint64_t
+            {
+                return Fold64Engine::processHardware(0, bytes, len);
+            });
+    }
+#endif // #ifdef EMBXX_CRC_FOLD_X86_HARDWARE
+}
+
+}  // namespace
+
+int main(int argc, const char* argv[])
+{
+    static_cast<void>(argc);
+    static_cast<void>(argv);
+
+    run(1024);
+    run(64 * 1024);
+    run(1024 * 1024);
+    return 0;
+}
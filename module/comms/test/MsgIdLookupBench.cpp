@@ -0,0 +1,201 @@
+//
+// Copyright 2014 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+// Measures lookup of message type by ID for 180 messages with dense IDs
+// (direct index table) and sparse IDs (perfect hash), both on its own
+// and as part of the whole MsgIdLayer::read().
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <tuple>
+#include <vector>
+
+#include "embxx/comms/Message.h"
+#include "embxx/comms/MessageHandler.h"
+#include "embxx/comms/MsgAllocators.h"
+#include "embxx/comms/MsgIdTable.h"
+#include "embxx/comms/protocol.h"
+#include "embxx/util/Tuple.h"
+
+namespace
+{
+
+namespace comms = embxx::comms;
+
+typedef comms::traits::MsgIdType MsgIdType;
+
+static const std::size_t NumOfMsgs = 180;
+static const std::size_t NumOfLookups = 4096;
+
+struct DenseIds
+{
+    static constexpr MsgIdType id(std::size_t idx)
+    {
+        return static_cast<MsgIdType>(idx + 1);
+    }
+};
+
+struct SparseIds
+{
+    static constexpr MsgIdType id(std::size_t idx)
+    {
+        return static_cast<MsgIdType>(3 + (idx * 37) + ((idx * idx) % 29));
+    }
+};
+
+template <typename TIds>
+struct Traits
+{
+    typedef TIds Ids;
+    typedef comms::traits::endian::Big Endianness;
+    typedef const char* ReadIterator;
+    typedef char* WriteIterator;
+    static const std::size_t MsgIdLen = 2;
+};
+
+template <typename TTraits>
+class Handler;
+
+template <typename TTraits>
+using MsgBase = comms::Message<Handler<TTraits>, TTraits>;
+
+template <MsgIdType TId, typename TTraits>
+class IdMsg : public comms::EmptyBodyMessage<TId, MsgBase<TTraits>, IdMsg<TId, TTraits> >
+{
+};
+
+template <typename TTraits, typename TIndices>
+struct MessagesOf;
+
+template <typename TTraits, std::size_t... TIndices>
+struct MessagesOf<TTraits, embxx::util::IndexSequence<TIndices...> >
+{
+    typedef std::tuple<IdMsg<TTraits::Ids::id(TIndices), TTraits>...> Type;
+};
+
+template <typename TTraits>
+struct AllMessages
+{
+    typedef typename MessagesOf<
+        TTraits,
+        typename embxx::util::MakeIndexSequence<NumOfMsgs>::Type
+    >::Type Type;
+};
+
+template <typename TTraits>
+class Handler : public comms::MessageHandler<
+                            MsgBase<TTraits>,
+                            typename AllMessages<TTraits>::Type>
+{
+};
+
+template <typename TIds>
+struct Stack
+{
+    typedef Traits<TIds> StackTraits;
+
+    typedef typename AllMessages<StackTraits>::Type Messages;
+
+    typedef comms::details::MsgIdTable<Messages> IdTable;
+
+    typedef comms::protocol::MsgIdLayer<
+        Messages,
+        comms::InPlaceMsgAllocator<Messages>,
+        StackTraits,
+        comms::protocol::MsgDataLayer<MsgBase<StackTraits> > > Type;
+};
+
+volatile std::uint64_t sink = 0;
+
+template <typename TFunc>
+double nsPerOp(std::size_t iterations, TFunc&& func)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t idx = 0; idx < iterations; ++idx) {
+        func();
+    }
+    auto end = std::chrono::steady_clock::now();
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    return static_cast<double>(ns) / static_cast<double>(iterations * NumOfLookups);
+}
+
+template <typename TIds>
+void measure(const char* name)
+{
+    typedef Stack<TIds> StackType;
+    typedef typename StackType::IdTable IdTable;
+
+    // Pseudo random order of the IDs, so the accessed entries of the
+    // lookup tables can't be predicted.
+    std::vector<MsgIdType> ids(NumOfLookups);
+    std::vector<char> frames(NumOfLookups * 2);
+    std::uint32_t seed = 12345;
+    for (std::size_t idx = 0; idx < NumOfLookups; ++idx) {
+        seed = (seed * 1103515245U) + 12345U;
+        auto id = TIds::id((seed >> 16) % NumOfMsgs);
+        ids[idx] = id;
+        frames[idx * 2] = static_cast<char>(id >> 8);
+        frames[(idx * 2) + 1] = static_cast<char>(id);
+    }
+
+    static const std::size_t Iterations = 2000;
+    auto findNs = nsPerOp(Iterations,
+        [&ids]()
+        {
+            std::uint64_t sum = 0;
+            for (auto id : ids) {
+                sum += IdTable::find(id);
+            }
+            sink = sum;
+        });
+
+    typename StackType::Type stack;
+    auto readNs = nsPerOp(Iterations,
+        [&stack, &frames]()
+        {
+            std::uint64_t sum = 0;
+            for (std::size_t idx = 0; idx < NumOfLookups; ++idx) {
+                typename StackType::Type::MsgPtr msg;
+                const char* iter = &frames[idx * 2];
+                auto es = stack.read(msg, iter, 2);
+                sum += static_cast<std::uint64_t>(es) + msg->getId();
+            }
+            sink = sum;
+        });
+
+    std::printf("%-7s IDs %u..%u (%s): find: %5.1f ns, MsgIdLayer::read: %5.1f ns\n",
+        name,
+        static_cast<unsigned>(TIds::id(0)),
+        static_cast<unsigned>(TIds::id(NumOfMsgs - 1)),
+        IdTable::Direct ? "direct table" : "perfect hash",
+        findNs,
+        readNs);
+}
+
+}  // namespace
+
+int main(int argc, const char* argv[])
+{
+    static_cast<void>(argc);
+    static_cast<void>(argv);
+
+    measure<DenseIds>("Dense");
+    measure<SparseIds>("Sparse");
+    return 0;
+}
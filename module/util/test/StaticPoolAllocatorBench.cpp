@@ -0,0 +1,218 @@
+//
+// Copyright 2014 (C). Alex Robenko. All rights reserved.
+//
+
+// This file is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+// Compares allocation time of StaticPoolAllocator with the previous
+// implementation, which searched std::bitset of allocation flags shifting
+// the requested mask one position at a time.
+
+#include <array>
+#include <bitset>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+
+#include "embxx/util/StaticPoolAllocator.h"
+
+namespace
+{
+
+typedef std::array<std::uint8_t, 64> Cell;
+
+// Copy of the previous std::bitset based search.
+template <std::size_t TSize>
+class BitsetPool
+{
+public:
+    Cell* allocate(std::size_t num)
+    {
+        if (TSize < num) {
+            return nullptr;
+        }
+
+        auto allocBitset = numToBitset(num);
+
+        std::size_t idx = 0;
+        while (idx <= (allocFlags_.size() - num)) {
+            auto checkBitmask = allocFlags_ & allocBitset;
+            if (checkBitmask.none()) {
+                allocFlags_ |= allocBitset;
+                return reinterpret_cast<Cell*>(&items_[idx]);
+            }
+
+            allocBitset <<= 1U;
+            ++idx;
+        }
+        return nullptr;
+    }
+
+    void deallocate(Cell* ptr, std::size_t num)
+    {
+        auto releaseBitset = numToBitset(num);
+        auto idx = static_cast<std::size_t>(
+            std::distance(reinterpret_cast<Cell*>(&items_[0]), ptr));
+        releaseBitset <<= idx;
+        allocFlags_ ^= releaseBitset;
+    }
+
+private:
+    typedef std::bitset<TSize> Bitset;
+
+    static Bitset numToBitset(std::size_t num)
+    {
+        typedef unsigned long long BitsetParamType;
+
+        static const std::size_t ChunkSize =
+            std::numeric_limits<BitsetParamType>::digits;
+
+        Bitset bitset;
+        auto remNum = num;
+        while (remNum >= ChunkSize) {
+            static const auto mask = ~(static_cast<BitsetParamType>(0));
+            bitset <<= ChunkSize;
+            bitset |= Bitset(mask);
+            remNum -= ChunkSize;
+        }
+
+        auto lastMask = (static_cast<BitsetParamType>(1U) << remNum) - 1;
+        bitset <<= remNum;
+        bitset |= Bitset(lastMask);
+        return bitset;
+    }
+
+    typedef typename std::aligned_storage<sizeof(Cell)>::type CellStorage;
+    std::array<CellStorage, TSize> items_;
+    Bitset allocFlags_;
+};
+
+template <std::size_t TSize>
+struct PoolTag {};
+
+template <std::size_t TSize>
+using WordPool = embxx::util::StaticPoolAllocator<PoolTag<TSize>, Cell, TSize>;
+
+volatile std::uintptr_t sink = 0;
+
+template <typename TFunc>
+double nsPerOp(std::size_t iterations, TFunc&& func)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t idx = 0; idx < iterations; ++idx) {
+        func();
+    }
+    auto end = std::chrono::steady_clock::now();
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    return static_cast<double>(ns) / static_cast<double>(iterations);
+}
+
+// The pool is filled leaving only the last cells free, then single cell
+// allocation and deallocation is measured, i.e. the whole pool needs to
+// be searched.
+template <std::size_t TSize, typename TPool>
+double lastCell(TPool& pool, std::size_t iterations)
+{
+    for (std::size_t idx = 0; idx < (TSize - 1); ++idx) {
+        pool.allocate(1);
+    }
+
+    return nsPerOp(iterations,
+        [&pool]()
+        {
+            auto* ptr = pool.allocate(1);
+            sink = reinterpret_cast<std::uintptr_t>(ptr);
+            pool.deallocate(ptr, 1);
+        });
+}
+
+// Every fourth cell of the pool is allocated, then allocation of four
+// consecutive cells is measured, which succeeds only at the end of the pool.
+template <std::size_t TSize, typename TPool>
+double multiCell(TPool& pool, std::size_t iterations)
+{
+    static const std::size_t Count = 4;
+    static const std::size_t Tail = Count * 2;
+    Cell* cells[TSize] = {nullptr};
+    for (std::size_t idx = 0; idx < (TSize - Tail); ++idx) {
+        cells[idx] = pool.allocate(1);
+    }
+
+    for (std::size_t idx = 0; idx < (TSize - Tail); ++idx) {
+        if ((idx % Count) != 0) {
+            pool.deallocate(cells[idx], 1);
+        }
+    }
+
+    return nsPerOp(iterations,
+        [&pool]()
+        {
+            auto* ptr = pool.allocate(Count);
+            sink = reinterpret_cast<std::uintptr_t>(ptr);
+            pool.deallocate(ptr, Count);
+        });
+}
+
+template <std::size_t TSize>
+void run(std::size_t oldIterations, std::size_t newIterations)
+{
+    {
+        static BitsetPool<TSize> pool;
+        std::printf("%5zu cells, last free cell, bitset:      %12.1f ns\n",
+            TSize, lastCell<TSize>(pool, oldIterations));
+    }
+
+    {
+        WordPool<TSize> pool;
+        std::printf("%5zu cells, last free cell, word bitmap: %12.1f ns\n",
+            TSize, lastCell<TSize>(pool, newIterations));
+    }
+}
+
+template <std::size_t TSize>
+void runMulti(std::size_t oldIterations, std::size_t newIterations)
+{
+    {
+        static BitsetPool<TSize> pool;
+        std::printf("%5zu cells, 4 cells fragmented, bitset:      %12.1f ns\n",
+            TSize, multiCell<TSize>(pool, oldIterations));
+    }
+
+    {
+        embxx::util::StaticPoolAllocator<PoolTag<TSize + 1>, Cell, TSize> pool;
+        std::printf("%5zu cells, 4 cells fragmented, word bitmap: %12.1f ns\n",
+            TSize, multiCell<TSize>(pool, newIterations));
+    }
+}
+
+}  // namespace
+
+int main(int argc, const char* argv[])
+{
+    static_cast<void>(argc);
+    static_cast<void>(argv);
+
+    run<64>(100000, 1000000);
+    run<1024>(2000, 1000000);
+    run<4096>(200, 1000000);
+
+    runMulti<64>(100000, 1000000);
+    runMulti<1024>(2000, 100000);
+    runMulti<4096>(200, 20000);
+    return 0;
+}